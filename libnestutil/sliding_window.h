@@ -0,0 +1,210 @@
+/*
+ *  sliding_window.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SLIDING_WINDOW_H
+#define SLIDING_WINDOW_H
+
+// C++ includes:
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace nest
+{
+
+/**
+ * Sorted sequence of elements within a sliding time window.
+ *
+ * Elements are inserted close to the back and removed from the front.
+ * They are stored contiguously in a vector, of which a prefix of removed
+ * elements is discarded once it makes up half of the vector. Since the
+ * vector keeps its capacity, a window of bounded size does not allocate
+ * memory after it has been filled once.
+ *
+ * T must provide operator>.
+ */
+template < typename T >
+class SlidingWindow
+{
+public:
+  typedef typename std::vector< T >::iterator iterator;
+  typedef typename std::vector< T >::const_iterator const_iterator;
+
+  SlidingWindow();
+
+  bool empty() const;
+  size_t size() const;
+
+  const T& front() const;
+
+  /**
+   * Remove first element.
+   */
+  void pop_front();
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  /**
+   * Return position of first element greater than value. Since elements
+   * arrive mostly in order, the search starts at the back.
+   */
+  iterator upper_bound( const T& value );
+
+  /**
+   * Insert value before pos and return its position.
+   */
+  iterator insert( iterator pos, const T& value );
+
+  /**
+   * Remove all elements, keeping the allocated memory.
+   */
+  void clear();
+
+private:
+  //! Discard removed elements at the beginning of the vector
+  void compact_();
+
+  std::vector< T > elements_;
+  size_t first_; //!< index of first element in window
+};
+
+template < typename T >
+inline SlidingWindow< T >::SlidingWindow()
+  : elements_()
+  , first_( 0 )
+{
+}
+
+template < typename T >
+inline bool
+SlidingWindow< T >::empty() const
+{
+  return first_ == elements_.size();
+}
+
+template < typename T >
+inline size_t
+SlidingWindow< T >::size() const
+{
+  return elements_.size() - first_;
+}
+
+template < typename T >
+inline const T&
+SlidingWindow< T >::front() const
+{
+  assert( not empty() );
+  return elements_[ first_ ];
+}
+
+template < typename T >
+inline void
+SlidingWindow< T >::pop_front()
+{
+  assert( not empty() );
+  ++first_;
+  if ( first_ == elements_.size() )
+  {
+    clear();
+  }
+  else if ( 2 * first_ >= elements_.size() )
+  {
+    compact_();
+  }
+}
+
+template < typename T >
+inline typename SlidingWindow< T >::iterator
+SlidingWindow< T >::begin()
+{
+  return elements_.begin() + first_;
+}
+
+template < typename T >
+inline typename SlidingWindow< T >::iterator
+SlidingWindow< T >::end()
+{
+  return elements_.end();
+}
+
+template < typename T >
+inline typename SlidingWindow< T >::const_iterator
+SlidingWindow< T >::begin() const
+{
+  return elements_.begin() + first_;
+}
+
+template < typename T >
+inline typename SlidingWindow< T >::const_iterator
+SlidingWindow< T >::end() const
+{
+  return elements_.end();
+}
+
+template < typename T >
+inline typename SlidingWindow< T >::iterator
+SlidingWindow< T >::upper_bound( const T& value )
+{
+  iterator pos = end();
+  while ( pos != begin() and *( pos - 1 ) > value )
+  {
+    --pos;
+  }
+  return pos;
+}
+
+template < typename T >
+inline typename SlidingWindow< T >::iterator
+SlidingWindow< T >::insert( iterator pos, const T& value )
+{
+  // reuse the space of removed elements before growing the vector
+  if ( elements_.size() == elements_.capacity() and first_ > 0 )
+  {
+    const size_t idx = pos - begin();
+    compact_();
+    pos = begin() + idx;
+  }
+  return elements_.insert( pos, value );
+}
+
+template < typename T >
+inline void
+SlidingWindow< T >::clear()
+{
+  elements_.clear();
+  first_ = 0;
+}
+
+template < typename T >
+inline void
+SlidingWindow< T >::compact_()
+{
+  elements_.erase( elements_.begin(), elements_.begin() + first_ );
+  first_ = 0;
+}
+
+} // namespace nest
+
+#endif /* SLIDING_WINDOW_H */
@@ -24,7 +24,6 @@
 
 // C++ includes:
 #include <cmath>      // for less
-#include <functional> // for bind2nd
 #include <numeric>
 
 // Includes from libnestutil:
@@ -316,25 +315,33 @@ nest::correlation_detector::handle( SpikeEvent& e )
         S_.histogram_correction_[ bin ] = ( t - S_.histogram_[ bin ] ) - y;
         S_.histogram_[ bin ] = t;
 
-        // pure (unweighted) count histogram
-        S_.count_histogram_[ bin ] += e.get_multiplicity();
+        // pure (unweighted) count histogram, counting each combined event
+        S_.count_histogram_[ bin ] += e.get_multiplicity() * spike_j->count_;
       }
 
     } // t in [TStart, Tstop]
 
-    // store the spike time in the according deque
+    // store the spike time in the according window
     // spikes are not guaranteed to arrive in temporal order,
     // so make an insertion sort
 
     // find first appearence of element which is greater than spike_i
     const Spike_ sp_i( spike_i, e.get_multiplicity() * e.get_weight() );
-    SpikelistType::iterator insert_pos = std::find_if( S_.incoming_[ sender ].begin(),
-      S_.incoming_[ sender ].end(),
-      std::bind( std::greater< Spike_ >(), std::placeholders::_1, sp_i ) );
-
-    // insert before the position we have found
-    // if no element greater found, insert_pos == end(), so append at the end of
-    // the deque
-    S_.incoming_[ sender ].insert( insert_pos, sp_i );
+    SpikelistType& ownSpikes = S_.incoming_[ sender ];
+    SpikelistType::iterator insert_pos = ownSpikes.upper_bound( sp_i );
+
+    if ( insert_pos != ownSpikes.begin() and ( insert_pos - 1 )->timestep_ == spike_i )
+    {
+      // combine with spikes already received for this time step
+      ( insert_pos - 1 )->weight_ += sp_i.weight_;
+      ++( insert_pos - 1 )->count_;
+    }
+    else
+    {
+      // insert before the position we have found
+      // if no element greater found, insert_pos == end(), so append at the
+      // end of the window
+      ownSpikes.insert( insert_pos, sp_i );
+    }
   } // device active
 }
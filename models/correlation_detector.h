@@ -25,9 +25,11 @@
 
 
 // C++ includes:
-#include <deque>
 #include <vector>
 
+// Includes from libnestutil:
+#include "sliding_window.h"
+
 // Includes from nestkernel:
 #include "event.h"
 #include "nest_timeconverter.h"
@@ -131,14 +133,10 @@ Correlation detector breaks with the persistence scheme as
 follows: the internal buffers for storing spikes are part
 of State_, but are initialized by init_buffers_().
 
-@todo The correlation detector could be made more efficient as follows
-(HEP 2008-07-01):
-- incoming_ is vector of two deques
-- let handle() push_back() entries in incoming_ and do nothing else
-- keep index to last "old spike" in each incoming_; cannot
-  be iterator since that may change
-- update() deletes all entries before now-tau_max, sorts the new
-  entries, then registers new entries in histogram
+Spikes of each source arriving in the same time step are combined into a
+single entry of the spike window of this source. The cost of a spike thus
+grows with the number of time steps within the correlation window that
+contain spikes of the other source, not with the number of these spikes.
 
 Example:
 
@@ -208,17 +206,19 @@ private:
   // ------------------------------------------------------------
 
   /**
-   * Spike structure to store in the deque of recently
-   * received events
+   * Spike structure to store in the window of recently
+   * received events. Combines all spikes in one time step.
    */
   struct Spike_
   {
     long timestep_;
-    double weight_;
+    double weight_; //!< summed weight of all spikes
+    long count_;    //!< number of spike events combined
 
     Spike_( long timestep, double weight )
       : timestep_( timestep )
       , weight_( weight )
+      , count_( 1 )
     {
     }
 
@@ -231,7 +231,7 @@ private:
     }
   };
 
-  typedef std::deque< Spike_ > SpikelistType;
+  typedef SlidingWindow< Spike_ > SpikelistType;
 
   // ------------------------------------------------------------
 
@@ -260,9 +260,6 @@ private:
   // ------------------------------------------------------------
 
   /**
-   * @todo Is there a replacement for std::list that allows fast
-   *       insertion inside, fast deletion at the beginning, and
-   *       maintains sorting?
    * @note Constructed with empty structures, which are set to
    *       proper sizes by init_buffers_().
    * @note State_ only contains read-out values, so we copy-construct
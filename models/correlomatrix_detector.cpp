@@ -24,7 +24,6 @@
 
 // C++ includes:
 #include <cmath>      // for less
-#include <functional> // for bind2nd
 #include <numeric>
 
 // Includes from libnestutil:
@@ -297,13 +296,29 @@ nest::correlomatrix_detector::handle( SpikeEvent& e )
 
     // find first appearence of element which is greater than spike_i
     const Spike_ sp_i( spike_i, e.get_multiplicity() * e.get_weight(), sender );
-    SpikelistType::iterator insert_pos = std::find_if(
-      S_.incoming_.begin(), S_.incoming_.end(), std::bind( std::greater< Spike_ >(), std::placeholders::_1, sp_i ) );
+    SpikelistType::iterator insert_pos = S_.incoming_.upper_bound( sp_i );
 
-    // insert before the position we have found
-    // if no element greater found, insert_pos == end(), so append at the end of
-    // the deque
-    S_.incoming_.insert( insert_pos, sp_i );
+    // look for spikes already received on this channel in this time step
+    SpikelistType::iterator same_pos = insert_pos;
+    while ( same_pos != S_.incoming_.begin() and ( same_pos - 1 )->timestep_ == spike_i
+      and ( same_pos - 1 )->receptor_channel_ != sender )
+    {
+      --same_pos;
+    }
+
+    if ( same_pos != S_.incoming_.begin() and ( same_pos - 1 )->timestep_ == spike_i )
+    {
+      // combine with these spikes
+      ( same_pos - 1 )->weight_ += sp_i.weight_;
+      ++( same_pos - 1 )->count_;
+    }
+    else
+    {
+      // insert before the position we have found
+      // if no element greater found, insert_pos == end(), so append at the
+      // end of the window
+      S_.incoming_.insert( insert_pos, sp_i );
+    }
 
     SpikelistType& otherSpikes = S_.incoming_;
     const double tau_edge = P_.tau_max_.get_steps() + 0.5 * P_.delta_tau_.get_steps();
@@ -366,11 +381,11 @@ nest::correlomatrix_detector::handle( SpikeEvent& e )
             S_.covariance_[ other_ind ][ sender_ind ][ bin ] +=
               e.get_multiplicity() * e.get_weight() * spike_j->weight_;
           }
-          // pure (unweighted) count histogram
-          S_.count_covariance_[ sender_ind ][ other_ind ][ bin ] += e.get_multiplicity();
+          // pure (unweighted) count histogram, counting each combined event
+          S_.count_covariance_[ sender_ind ][ other_ind ][ bin ] += e.get_multiplicity() * spike_j->count_;
           if ( bin == 0 && ( spike_i - spike_j->timestep_ != 0 || other != sender ) )
           {
-            S_.count_covariance_[ other_ind ][ sender_ind ][ bin ] += e.get_multiplicity();
+            S_.count_covariance_[ other_ind ][ sender_ind ][ bin ] += e.get_multiplicity() * spike_j->count_;
           }
         }
       }
@@ -25,9 +25,11 @@
 
 
 // C++ includes:
-#include <deque>
 #include <vector>
 
+// Includes from libnestutil:
+#include "sliding_window.h"
+
 // Includes from nestkernel:
 #include "event.h"
 #include "nest_timeconverter.h"
@@ -90,14 +92,10 @@ sense.
  follows: the internal buffers for storing spikes are part
  of State_, but are initialized by init_buffers_().
 
- @todo The correlation detector could be made more efficient as follows
- (HEP 2008-07-01):
- - incoming_ is vector of two deques
- - let handle() push_back() entries in incoming_ and do nothing else
- - keep index to last "old spike" in each incoming_; cannot
-   be iterator since that may change
- - update() deletes all entries before now-tau_max, sorts the new
-   entries, then registers new entries in histogram
+ Spikes arriving on the same channel in the same time step are combined
+ into a single entry of the spike window. The cost of a spike thus grows
+ with the number of distinct pairs of channel and time step within the
+ correlation window, not with the number of spikes.
 
 Parameters
 ++++++++++
@@ -194,19 +192,21 @@ private:
   // ------------------------------------------------------------
 
   /**
-   * Spike structure to store in the deque of recently
-   * received events
+   * Spike structure to store in the window of recently
+   * received events. Combines all spikes of one channel in one time step.
    */
   struct Spike_
   {
     long timestep_;
-    double weight_;
+    double weight_; //!< summed weight of all spikes
     long receptor_channel_;
+    long count_; //!< number of spike events combined
 
     Spike_( long timestep, double weight, long receptorchannel )
       : timestep_( timestep )
       , weight_( weight )
       , receptor_channel_( receptorchannel )
+      , count_( 1 )
     {
     }
 
@@ -219,7 +219,7 @@ private:
     }
   };
 
-  typedef std::deque< Spike_ > SpikelistType;
+  typedef SlidingWindow< Spike_ > SpikelistType;
 
   // ------------------------------------------------------------
 
@@ -249,9 +249,6 @@ private:
   // ------------------------------------------------------------
 
   /**
-   * @todo Is there a replacement for std::list that allows fast
-   *       insertion inside, fast deletion at the beginning, and
-   *       maintains sorting?
    * @note Constructed with empty structures, which are set to
    *       proper sizes by init_buffers_().
    * @note State_ only contains read-out values, so we copy-construct
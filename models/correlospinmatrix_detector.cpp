@@ -24,7 +24,6 @@
 
 // C++ includes:
 #include <cmath>
-#include <functional>
 #include <numeric>
 
 // Includes from libnestutil:
@@ -397,13 +396,11 @@ nest::correlospinmatrix_detector::handle( SpikeEvent& e )
       // must happen here so event is taken into account in autocorrelation
       const BinaryPulse_ bp_i( t_i_on, t_i_off, i );
 
-      BinaryPulselistType::iterator insert_pos = std::find_if( S_.incoming_.begin(),
-        S_.incoming_.end(),
-        std::bind( std::greater< BinaryPulse_ >(), std::placeholders::_1, bp_i ) );
+      BinaryPulselistType::iterator insert_pos = S_.incoming_.upper_bound( bp_i );
 
       // insert before the position we have found
       // if no element greater found, insert_pos == end(), so append at the end
-      // of the deque
+      // of the window
       S_.incoming_.insert( insert_pos, bp_i );
 
 
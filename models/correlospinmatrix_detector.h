@@ -25,9 +25,11 @@
 
 
 // C++ includes:
-#include <deque>
 #include <vector>
 
+// Includes from libnestutil:
+#include "sliding_window.h"
+
 // Includes from nestkernel:
 #include "event.h"
 #include "nest_timeconverter.h"
@@ -180,7 +182,7 @@ private:
   // ------------------------------------------------------------
 
   /**
-   * Structure to store in the deque of recently
+   * Structure to store in the window of recently
    * received events marked by beginning and end of the binary on pulse
    */
   struct BinaryPulse_
@@ -205,7 +207,7 @@ private:
     }
   };
 
-  typedef std::deque< BinaryPulse_ > BinaryPulselistType;
+  typedef SlidingWindow< BinaryPulse_ > BinaryPulselistType;
 
   // ------------------------------------------------------------
 
@@ -235,9 +237,6 @@ private:
   // ------------------------------------------------------------
 
   /**
-   * @todo Is there a replacement for std::list that allows fast
-   *       insertion inside, fast deletion at the beginning, and
-   *       maintains sorting?
    * @note Constructed with empty structures, which are set to
    *       proper sizes by init_buffers_().
    * @note State_ only contains read-out values, so we copy-construct
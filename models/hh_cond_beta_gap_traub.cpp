@@ -26,6 +26,7 @@
 #ifdef HAVE_GSL
 
 // C++ includes:
+#include <algorithm>
 #include <cmath> // in case we need isnan() // fabs
 #include <cstdio>
 #include <iomanip>
@@ -403,6 +404,10 @@ nest::hh_cond_beta_gap_traub::init_buffers_()
     kernel().connection_manager.get_min_delay() * ( kernel().simulation_manager.get_wfr_interpolation_order() + 1 );
 
   B_.interpolation_coefficients.resize( buffer_size, 0.0 );
+  B_.last_interpolation_coefficients.resize( buffer_size, 0.0 );
+  B_.last_new_coefficients.resize( buffer_size, 0.0 );
+  B_.wfr_converged_ = false;
+  B_.last_sent_coefficients_.clear();
 
   B_.last_y_values.resize( kernel().connection_manager.get_min_delay(), 0.0 );
 
@@ -495,6 +500,40 @@ nest::hh_cond_beta_gap_traub::update_( Time const& origin,
   const size_t buffer_size = kernel().connection_manager.get_min_delay() * ( interpolation_order + 1 );
   std::vector< double > new_coefficients( buffer_size, 0.0 );
 
+  // adaptive waveform relaxation: if this neuron converged in the previous
+  // iteration and its input did not change by more than wfr_tol, another
+  // integration would reproduce the previous result, so the neuron is frozen
+  // for this iteration and only resends its previous coefficients
+  if ( called_from_wfr_update and kernel().simulation_manager.get_wfr_adaptive() )
+  {
+    // the received coefficients are sums of the presynaptic voltage
+    // coefficients weighted by g_ij, so their change is compared to wfr_tol
+    // scaled by the total coupling, i.e., as a change of the mean voltage
+    const double tol = wfr_tol * fabs( B_.sumj_g_ij_ );
+    bool input_changed = not B_.wfr_converged_;
+    for ( size_t i = 0; i < buffer_size and not input_changed; ++i )
+    {
+      input_changed = fabs( B_.interpolation_coefficients[ i ] - B_.last_interpolation_coefficients[ i ] ) > tol;
+    }
+    B_.last_interpolation_coefficients = B_.interpolation_coefficients;
+
+    if ( not input_changed )
+    {
+      if ( kernel().event_delivery_manager.secondary_payload_changed(
+             B_.last_sent_coefficients_, B_.last_new_coefficients ) )
+      {
+        GapJunctionEvent ge;
+        ge.set_coeffarray( B_.last_new_coefficients );
+        kernel().event_delivery_manager.send_secondary( *this, ge );
+      }
+
+      B_.sumj_g_ij_ = 0.0;
+      std::fill( B_.interpolation_coefficients.begin(), B_.interpolation_coefficients.end(), 0.0 );
+
+      return false;
+    }
+  }
+
   // parameters needed for piecewise interpolation
   double y_i = 0.0, y_ip1 = 0.0, hf_i = 0.0, hf_ip1 = 0.0;
   double f_temp[ State_::STATE_VEC_SIZE ];
@@ -628,12 +667,23 @@ nest::hh_cond_beta_gap_traub::update_( Time const& origin,
     }
 
     std::vector< double >( kernel().connection_manager.get_min_delay(), 0.0 ).swap( B_.last_y_values );
+
+    // the next slice starts with a full wfr iteration for every neuron
+    B_.wfr_converged_ = false;
+  }
+  else if ( kernel().simulation_manager.get_wfr_adaptive() )
+  {
+    B_.last_new_coefficients = new_coefficients;
+    B_.wfr_converged_ = not wfr_tol_exceeded;
   }
 
   // Send gap-event
-  GapJunctionEvent ge;
-  ge.set_coeffarray( new_coefficients );
-  kernel().event_delivery_manager.send_secondary( *this, ge );
+  if ( kernel().event_delivery_manager.secondary_payload_changed( B_.last_sent_coefficients_, new_coefficients ) )
+  {
+    GapJunctionEvent ge;
+    ge.set_coeffarray( new_coefficients );
+    kernel().event_delivery_manager.send_secondary( *this, ge );
+  }
 
   // Reset variables
   B_.sumj_g_ij_ = 0.0;
@@ -370,6 +370,16 @@ public:
 
     // summarized coefficients of the interpolation polynomial
     std::vector< double > interpolation_coefficients;
+    // coefficients received in the last wfr_update (only used if
+    // wfr_adaptive is set)
+    std::vector< double > last_interpolation_coefficients;
+    // coefficients sent in the last wfr_update (only used if
+    // wfr_adaptive is set)
+    std::vector< double > last_new_coefficients;
+    // true if the last wfr_update of this neuron has converged
+    bool wfr_converged_;
+    // coefficients sent last (only used if use_secondary_delta is set)
+    std::vector< double > last_sent_coefficients_;
 
     /**
      * Input current injected by CurrentEvent.
@@ -109,6 +109,7 @@
 #include "correlomatrix_detector.h"
 #include "correlospinmatrix_detector.h"
 #include "multimeter.h"
+#include "spike_count_recorder.h"
 #include "spike_recorder.h"
 #include "spin_detector.h"
 #include "volume_transmitter.h"
@@ -254,6 +255,7 @@ ModelsModule::init( SLIInterpreter* )
   kernel().model_manager.register_node_model< spike_dilutor >( "spike_dilutor" );
 
   kernel().model_manager.register_node_model< spike_recorder >( "spike_recorder" );
+  kernel().model_manager.register_node_model< spike_count_recorder >( "spike_count_recorder" );
   kernel().model_manager.register_node_model< weight_recorder >( "weight_recorder" );
   kernel().model_manager.register_node_model< spin_detector >( "spin_detector" );
   kernel().model_manager.register_node_model< multimeter >( "multimeter" );
@@ -22,6 +22,10 @@
 
 #include "multimeter.h"
 
+// C++ includes:
+#include <algorithm>
+#include <string>
+
 // Includes from nestkernel:
 #include "event_delivery_manager_impl.h"
 
@@ -62,6 +66,7 @@ nest::multimeter::Parameters_::Parameters_()
   : interval_( Time::ms( 1.0 ) )
   , offset_( Time::ms( 0. ) )
   , record_from_()
+  , aggregation_( AGGREGATE_NONE )
 {
 }
 
@@ -69,15 +74,49 @@ nest::multimeter::Parameters_::Parameters_( const Parameters_& p )
   : interval_( p.interval_ )
   , offset_( p.offset_ )
   , record_from_( p.record_from_ )
+  , aggregation_( p.aggregation_ )
 {
   interval_.calibrate();
 }
 
 nest::multimeter::Buffers_::Buffers_()
   : has_targets_( false )
+  , aggregates_()
 {
 }
 
+nest::multimeter::Aggregate_::Aggregate_( const DataLoggingReply::Item& item, Aggregation aggregation )
+  : timestamp_( item.timestamp )
+  , n_( 1 )
+  , low_( item.data )
+  , high_( aggregation == AGGREGATE_MEAN ? std::vector< double >( item.data.size(), 0. ) : item.data )
+{
+}
+
+void
+nest::multimeter::Aggregate_::add( const DataLoggingReply::Item& item, Aggregation aggregation )
+{
+  ++n_;
+  if ( aggregation == AGGREGATE_MEAN )
+  {
+    // Welford's algorithm, see Knuth, TAOCP vol 2, 3rd ed, p 232
+    for ( size_t i = 0; i < low_.size(); ++i )
+    {
+      const double delta = item.data[ i ] - low_[ i ];
+      low_[ i ] += delta / n_;
+      high_[ i ] += delta * ( item.data[ i ] - low_[ i ] );
+    }
+  }
+  else
+  {
+    for ( size_t i = 0; i < low_.size(); ++i )
+    {
+      low_[ i ] = std::min( low_[ i ], item.data[ i ] );
+      high_[ i ] = std::max( high_[ i ], item.data[ i ] );
+    }
+  }
+}
+
 void
 nest::multimeter::Parameters_::get( DictionaryDatum& d ) const
 {
@@ -89,18 +128,32 @@ nest::multimeter::Parameters_::get( DictionaryDatum& d ) const
     ad.push_back( LiteralDatum( record_from_[ j ] ) );
   }
   ( *d )[ names::record_from ] = ad;
+
+  switch ( aggregation_ )
+  {
+  case AGGREGATE_NONE:
+    ( *d )[ names::aggregation ] = LiteralDatum( names::none );
+    break;
+  case AGGREGATE_MEAN:
+    ( *d )[ names::aggregation ] = LiteralDatum( names::mean );
+    break;
+  case AGGREGATE_MIN_MAX:
+    ( *d )[ names::aggregation ] = LiteralDatum( names::min_max );
+    break;
+  }
 }
 
 void
 nest::multimeter::Parameters_::set( const DictionaryDatum& d, const Buffers_& b, Node* node )
 {
   if ( b.has_targets_
-    && ( d->known( names::interval ) || d->known( names::offset ) || d->known( names::record_from ) ) )
+    && ( d->known( names::interval ) || d->known( names::offset ) || d->known( names::record_from )
+         || d->known( names::aggregation ) ) )
   {
     throw BadProperty(
-      "The recording interval, the interval offset and the list of properties "
-      "to record cannot be changed after the multimeter has been connected "
-      "to nodes." );
+      "The recording interval, the interval offset, the list of properties "
+      "to record and the aggregation cannot be changed after the multimeter "
+      "has been connected to nodes." );
   }
 
   double v;
@@ -155,12 +208,48 @@ nest::multimeter::Parameters_::set( const DictionaryDatum& d, const Buffers_& b,
       record_from_.push_back( Name( getValue< std::string >( *t ) ) );
     }
   }
+
+  if ( d->known( names::aggregation ) )
+  {
+    const Name aggregation( getValue< std::string >( d, names::aggregation ) );
+    if ( aggregation == names::none )
+    {
+      aggregation_ = AGGREGATE_NONE;
+    }
+    else if ( aggregation == names::mean )
+    {
+      aggregation_ = AGGREGATE_MEAN;
+    }
+    else if ( aggregation == names::min_max )
+    {
+      aggregation_ = AGGREGATE_MIN_MAX;
+    }
+    else
+    {
+      throw BadProperty( "aggregation must be one of 'none', 'mean' or 'min_max'." );
+    }
+  }
 }
 
 void
 multimeter::calibrate()
 {
-  RecordingDevice::calibrate( P_.record_from_, RecordingBackend::NO_LONG_VALUE_NAMES );
+  if ( P_.aggregation_ == AGGREGATE_NONE )
+  {
+    RecordingDevice::calibrate( P_.record_from_, RecordingBackend::NO_LONG_VALUE_NAMES );
+    return;
+  }
+
+  const std::string low_suffix = P_.aggregation_ == AGGREGATE_MEAN ? "_mean" : "_min";
+  const std::string high_suffix = P_.aggregation_ == AGGREGATE_MEAN ? "_var" : "_max";
+
+  std::vector< Name > value_names;
+  for ( size_t j = 0; j < P_.record_from_.size(); ++j )
+  {
+    value_names.push_back( Name( P_.record_from_[ j ].toString() + low_suffix ) );
+    value_names.push_back( Name( P_.record_from_[ j ].toString() + high_suffix ) );
+  }
+  RecordingDevice::calibrate( value_names, std::vector< Name >( 1, names::n_neurons ) );
 }
 
 void
@@ -185,6 +274,12 @@ multimeter::update( Time const& origin, const long from, const long )
   // Note that not all nodes receiving the request will necessarily answer.
   DataLoggingRequest req;
   kernel().event_delivery_manager.send( *this, req );
+
+  // all targets have replied, so the statistics are complete
+  if ( P_.aggregation_ != AGGREGATE_NONE )
+  {
+    write_aggregates_();
+  }
 }
 
 void
@@ -193,30 +288,86 @@ multimeter::handle( DataLoggingReply& reply )
   // easy access to relevant information
   DataLoggingReply::Container const& info = reply.get_info();
 
-  // count records that have been skipped during inactivity
-  size_t inactive_skipped = 0;
-
-  // record all data, time point by time point
-  for ( size_t j = 0; j < info.size(); ++j )
+  // record all data, passing each run of consecutive time points during
+  // which the multimeter is active to the backend at once
+  size_t j = 0;
+  while ( j < info.size() and info[ j ].timestamp.is_finite() )
   {
-    if ( not info[ j ].timestamp.is_finite() )
+    if ( not is_active( info[ j ].timestamp ) )
     {
-      break;
+      ++j;
+      continue;
     }
 
-    if ( not is_active( info[ j ].timestamp ) )
+    const size_t begin = j;
+    while ( j < info.size() and info[ j ].timestamp.is_finite() and is_active( info[ j ].timestamp ) )
     {
-      ++inactive_skipped;
-      continue;
+      ++j;
     }
 
-    reply.set_stamp( info[ j ].timestamp );
-    // const index sender = reply.get_sender_node_id();
-    // const Time stamp = reply.get_stamp();
-    // const double offset = reply.get_offset();
+    if ( P_.aggregation_ == AGGREGATE_NONE )
+    {
+      write_samples( reply, begin, j );
+    }
+    else
+    {
+      // entries are sorted by time, so search each from the previous one
+      size_t pos = 0;
+      for ( size_t k = begin; k < j; ++k )
+      {
+        pos = aggregate_( info[ k ], pos );
+      }
+    }
+  }
+}
 
-    write( reply, info[ j ].data, RecordingBackend::NO_LONG_VALUES );
+size_t
+multimeter::aggregate_( const DataLoggingReply::Item& item, size_t pos )
+{
+  // all targets are sampled at the same time points, so the entry for the
+  // time point is usually found at once
+  while ( pos < B_.aggregates_.size() and B_.aggregates_[ pos ].timestamp_ < item.timestamp )
+  {
+    ++pos;
   }
+
+  if ( pos < B_.aggregates_.size() and B_.aggregates_[ pos ].timestamp_ == item.timestamp )
+  {
+    B_.aggregates_[ pos ].add( item, P_.aggregation_ );
+  }
+  else
+  {
+    B_.aggregates_.insert( B_.aggregates_.begin() + pos, Aggregate_( item, P_.aggregation_ ) );
+  }
+  return pos;
+}
+
+void
+multimeter::write_aggregates_()
+{
+  // statistics are recorded with the multimeter as sender
+  const DataLoggingReply::Container no_data;
+  DataLoggingReply reply( no_data );
+  reply.set_sender( *this );
+  reply.set_sender_node_id( get_node_id() );
+
+  std::vector< double > values( 2 * P_.record_from_.size() );
+  std::vector< long > n_neurons( 1 );
+
+  for ( std::vector< Aggregate_ >::const_iterator a = B_.aggregates_.begin(); a != B_.aggregates_.end(); ++a )
+  {
+    for ( size_t i = 0; i < a->low_.size(); ++i )
+    {
+      values[ 2 * i ] = a->low_[ i ];
+      values[ 2 * i + 1 ] = P_.aggregation_ == AGGREGATE_MEAN ? a->high_[ i ] / a->n_ : a->high_[ i ];
+    }
+    n_neurons[ 0 ] = a->n_;
+
+    reply.set_stamp( a->timestamp_ );
+    write( reply, values, n_neurons );
+  }
+
+  B_.aggregates_.clear();
 }
 
 RecordingDevice::Type
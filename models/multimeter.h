@@ -104,6 +104,32 @@ support the sampling of the values *V_m* and *g_ex*. It would also
 fail if carried out in the wrong direction, i.e., trying to connect the
 *neurons* to *mm*.
 
+Instead of the raw per-neuron traces, the ``multimeter`` can record
+statistics over the population of neurons it is connected to. The
+``aggregation`` property selects the statistics:
+
+``none``
+   Record the value of each variable for each neuron (default).
+
+``mean``
+   Record mean and variance of each variable over the population, with
+   the suffixes ``_mean`` and ``_var`` added to the variable names.
+
+``min_max``
+   Record minimum and maximum of each variable over the population, with
+   the suffixes ``_min`` and ``_max`` added to the variable names.
+
+::
+
+   mm = nest.Create('multimeter', 1, {'record_from': ['V_m'], 'aggregation': 'mean'})
+
+The statistics are computed separately on each thread, for the neurons
+local to that thread, and recorded with the ``multimeter`` as sender
+once per sampling time point. The number of neurons included is
+recorded as ``n_neurons``, so that results from several threads or
+processes can be combined. Like ``record_from``, ``aggregation`` cannot
+be changed after the ``multimeter`` is connected to any neuron.
+
 .. note::
 
    A pre-configured  ``multimeter`` is available under the name ``voltmeter``.  Its
@@ -172,6 +198,43 @@ protected:
   void update( Time const&, const long, const long );
 
 private:
+  /**
+   * Statistics recorded instead of the sampled values.
+   */
+  enum Aggregation
+  {
+    AGGREGATE_NONE,   //!< record sampled values
+    AGGREGATE_MEAN,   //!< record population mean and variance
+    AGGREGATE_MIN_MAX //!< record population minimum and maximum
+  };
+
+  /**
+   * Statistics of the values sampled at one time point.
+   */
+  struct Aggregate_
+  {
+    Aggregate_( const DataLoggingReply::Item&, Aggregation );
+
+    //! Include values sampled from another neuron
+    void add( const DataLoggingReply::Item&, Aggregation );
+
+    Time timestamp_;
+    long n_;                     //!< number of neurons sampled
+    std::vector< double > low_;  //!< mean or minimum
+    std::vector< double > high_; //!< sum of squared deviations or maximum
+  };
+
+  /**
+   * Include values sampled from one neuron into the statistics.
+   * @param pos index of statistics at which to start searching for the
+   *            time point of the values
+   * @returns index of statistics of the time point
+   */
+  size_t aggregate_( const DataLoggingReply::Item&, size_t pos );
+
+  //! Record statistics of all time points sampled during the last slice
+  void write_aggregates_();
+
   struct Buffers_;
 
   struct Parameters_
@@ -179,6 +242,7 @@ private:
     Time interval_;                   //!< recording interval, in ms
     Time offset_;                     //!< offset relative to which interval is calculated, in ms
     std::vector< Name > record_from_; //!< which data to record
+    Aggregation aggregation_;         //!< statistics to record instead of values
 
     Parameters_();
     Parameters_( const Parameters_& );
@@ -198,6 +262,9 @@ private:
     Buffers_();
 
     bool has_targets_;
+
+    //! statistics of sampled time points, sorted by time
+    std::vector< Aggregate_ > aggregates_;
   };
 
   // ------------------------------------------------------------
@@ -231,6 +231,8 @@ nest::rate_neuron_ipn< TNonlinearities >::init_buffers_()
   B_.instant_rates_ex_.resize( buffer_size, 0.0 );
   B_.instant_rates_in_.resize( buffer_size, 0.0 );
   B_.last_y_values.resize( buffer_size, 0.0 );
+  B_.last_sent_delayed_rates_.clear();
+  B_.last_sent_instant_rates_.clear();
   B_.random_numbers.resize( buffer_size, numerics::nan );
 
   // initialize random numbers
@@ -369,9 +371,12 @@ nest::rate_neuron_ipn< TNonlinearities >::update_( Time const& origin,
   {
     // Send delay-rate-neuron-event. This only happens in the final iteration
     // to avoid accumulation in the buffers of the receiving neurons.
-    DelayedRateConnectionEvent drve;
-    drve.set_coeffarray( new_rates );
-    kernel().event_delivery_manager.send_secondary( *this, drve );
+    if ( kernel().event_delivery_manager.secondary_payload_changed( B_.last_sent_delayed_rates_, new_rates ) )
+    {
+      DelayedRateConnectionEvent drve;
+      drve.set_coeffarray( new_rates );
+      kernel().event_delivery_manager.send_secondary( *this, drve );
+    }
 
     // clear last_y_values
     std::vector< double >( buffer_size, 0.0 ).swap( B_.last_y_values );
@@ -391,9 +396,12 @@ nest::rate_neuron_ipn< TNonlinearities >::update_( Time const& origin,
   }
 
   // Send rate-neuron-event
-  InstantaneousRateConnectionEvent rve;
-  rve.set_coeffarray( new_rates );
-  kernel().event_delivery_manager.send_secondary( *this, rve );
+  if ( kernel().event_delivery_manager.secondary_payload_changed( B_.last_sent_instant_rates_, new_rates ) )
+  {
+    InstantaneousRateConnectionEvent rve;
+    rve.set_coeffarray( new_rates );
+    kernel().event_delivery_manager.send_secondary( *this, rve );
+  }
 
   // Reset variables
   std::vector< double >( buffer_size, 0.0 ).swap( B_.instant_rates_ex_ );
@@ -237,6 +237,10 @@ private:
     std::vector< double > instant_rates_in_; //!< buffer for rate vector received
     // by RateConnectionInstantaneous
     std::vector< double > last_y_values;  //!< remembers y_values from last wfr_update
+    std::vector< double > last_sent_delayed_rates_; //!< rates sent last by
+    // DelayedRateConnectionEvent, used if use_secondary_delta is set
+    std::vector< double > last_sent_instant_rates_; //!< rates sent last by
+    // InstantaneousRateConnectionEvent, used if use_secondary_delta is set
     std::vector< double > random_numbers; //!< remembers the random_numbers in
     // order to apply the same random
     // numbers in each iteration when wfr
@@ -215,6 +215,8 @@ nest::rate_neuron_opn< TNonlinearities >::init_buffers_()
   B_.instant_rates_ex_.resize( buffer_size, 0.0 );
   B_.instant_rates_in_.resize( buffer_size, 0.0 );
   B_.last_y_values.resize( buffer_size, 0.0 );
+  B_.last_sent_delayed_rates_.clear();
+  B_.last_sent_instant_rates_.clear();
   B_.random_numbers.resize( buffer_size, numerics::nan );
 
   // initialize random numbers
@@ -340,9 +342,12 @@ nest::rate_neuron_opn< TNonlinearities >::update_( Time const& origin,
   {
     // Send delay-rate-neuron-event. This only happens in the final iteration
     // to avoid accumulation in the buffers of the receiving neurons.
-    DelayedRateConnectionEvent drve;
-    drve.set_coeffarray( new_rates );
-    kernel().event_delivery_manager.send_secondary( *this, drve );
+    if ( kernel().event_delivery_manager.secondary_payload_changed( B_.last_sent_delayed_rates_, new_rates ) )
+    {
+      DelayedRateConnectionEvent drve;
+      drve.set_coeffarray( new_rates );
+      kernel().event_delivery_manager.send_secondary( *this, drve );
+    }
 
     // clear last_y_values
     std::vector< double >( buffer_size, 0.0 ).swap( B_.last_y_values );
@@ -362,9 +367,12 @@ nest::rate_neuron_opn< TNonlinearities >::update_( Time const& origin,
   }
 
   // Send rate-neuron-event
-  InstantaneousRateConnectionEvent rve;
-  rve.set_coeffarray( new_rates );
-  kernel().event_delivery_manager.send_secondary( *this, rve );
+  if ( kernel().event_delivery_manager.secondary_payload_changed( B_.last_sent_instant_rates_, new_rates ) )
+  {
+    InstantaneousRateConnectionEvent rve;
+    rve.set_coeffarray( new_rates );
+    kernel().event_delivery_manager.send_secondary( *this, rve );
+  }
 
   // Reset variables
   std::vector< double >( buffer_size, 0.0 ).swap( B_.instant_rates_ex_ );
@@ -218,6 +218,11 @@ private:
     // remembers y_values from last wfr_update
     std::vector< double > last_y_values;
 
+    // rates sent last by DelayedRateConnectionEvent and
+    // InstantaneousRateConnectionEvent, used if use_secondary_delta is set
+    std::vector< double > last_sent_delayed_rates_;
+    std::vector< double > last_sent_instant_rates_;
+
     //! Logger for all analog data
     UniversalDataLogger< rate_transformer_node > logger_;
   };
@@ -365,6 +365,7 @@ nest::siegert_neuron::init_buffers_()
   B_.drift_input_.resize( buffer_size, 0.0 );
   B_.diffusion_input_.resize( buffer_size, 0.0 );
   B_.last_y_values.resize( buffer_size, 0.0 );
+  B_.last_sent_rates_.clear();
 
   B_.logger_.reset(); // includes resize
   Archiving_Node::clear_history();
@@ -435,9 +436,12 @@ nest::siegert_neuron::update_( Time const& origin, const long from, const long t
   }
 
   // Send diffusion-event
-  DiffusionConnectionEvent rve;
-  rve.set_coeffarray( new_rates );
-  kernel().event_delivery_manager.send_secondary( *this, rve );
+  if ( kernel().event_delivery_manager.secondary_payload_changed( B_.last_sent_rates_, new_rates ) )
+  {
+    DiffusionConnectionEvent rve;
+    rve.set_coeffarray( new_rates );
+    kernel().event_delivery_manager.send_secondary( *this, rve );
+  }
 
   // Reset variables
   std::vector< double >( buffer_size, 0.0 ).swap( B_.drift_input_ );
@@ -248,6 +248,8 @@ private:
     std::vector< double > diffusion_input_; //!< buffer for diffusion term
     // received by DiffusionConnection
     std::vector< double > last_y_values;           //!< remembers y_values from last wfr_update
+    std::vector< double > last_sent_rates_;        //!< rates sent last, used if
+                                                   //!< use_secondary_delta is set
     UniversalDataLogger< siegert_neuron > logger_; //!< Logger for all analog data
   };
 
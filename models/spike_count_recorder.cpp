@@ -0,0 +1,363 @@
+/*
+ *  spike_count_recorder.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "spike_count_recorder.h"
+
+// C++ includes:
+#include <algorithm>
+
+// Includes from libnestutil:
+#include "dict_util.h"
+
+// Includes from nestkernel:
+#include "kernel_manager.h"
+
+// Includes from sli:
+#include "arraydatum.h"
+#include "dict.h"
+#include "dictutils.h"
+
+
+/* ----------------------------------------------------------------
+ * Default constructors defining default parameters and state
+ * ---------------------------------------------------------------- */
+
+nest::spike_count_recorder::Parameters_::Parameters_()
+  : bin_width_( Time::ms( 1.0 ) )
+  , per_neuron_( false )
+{
+}
+
+nest::spike_count_recorder::Parameters_::Parameters_( const Parameters_& p )
+  : bin_width_( p.bin_width_ )
+  , per_neuron_( p.per_neuron_ )
+{
+  bin_width_.calibrate();
+}
+
+nest::spike_count_recorder::State_::State_()
+  : n_events_( 0 )
+  , counts_()
+  , neuron_counts_()
+{
+}
+
+
+/* ----------------------------------------------------------------
+ * Parameter extraction and manipulation functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::spike_count_recorder::Parameters_::get( DictionaryDatum& d ) const
+{
+  ( *d )[ names::bin_width ] = bin_width_.get_ms();
+  ( *d )[ names::per_neuron ] = per_neuron_;
+}
+
+void
+nest::spike_count_recorder::State_::get( DictionaryDatum& d,
+  const Parameters_& p,
+  size_t n_bins,
+  const std::map< index, std::vector< long > >& neuron_counts ) const
+{
+  ( *d )[ names::n_events ] = n_events_;
+
+  if ( not p.per_neuron_ )
+  {
+    std::vector< long >* counts = new std::vector< long >( counts_ );
+    if ( counts->size() < n_bins )
+    {
+      counts->resize( n_bins, 0 );
+    }
+    ( *d )[ names::counts ] = IntVectorDatum( counts );
+    return;
+  }
+
+  std::vector< long >* senders = new std::vector< long >();
+  ArrayDatum counts;
+  for ( std::map< index, std::vector< long > >::const_iterator it = neuron_counts.begin(); it != neuron_counts.end();
+        ++it )
+  {
+    senders->push_back( it->first );
+    std::vector< long >* sender_counts = new std::vector< long >( it->second );
+    if ( sender_counts->size() < n_bins )
+    {
+      sender_counts->resize( n_bins, 0 );
+    }
+    counts.push_back( IntVectorDatum( sender_counts ) );
+  }
+  ( *d )[ names::senders ] = IntVectorDatum( senders );
+  ( *d )[ names::counts ] = counts;
+}
+
+bool
+nest::spike_count_recorder::Parameters_::set( const DictionaryDatum& d, const spike_count_recorder& n, Node* node )
+{
+  bool reset = false;
+  double t;
+  if ( updateValueParam< double >( d, names::bin_width, t, node ) )
+  {
+    bin_width_ = Time::ms( t );
+    reset = true;
+  }
+
+  if ( updateValueParam< bool >( d, names::per_neuron, per_neuron_, node ) )
+  {
+    reset = true;
+  }
+
+  if ( not bin_width_.is_step() )
+  {
+    throw StepMultipleRequired( n.get_name(), names::bin_width, bin_width_ );
+  }
+
+  return reset;
+}
+
+void
+nest::spike_count_recorder::State_::set( const DictionaryDatum& d, bool reset_required, Node* )
+{
+  long nev;
+  if ( updateValue< long >( d, names::n_events, nev ) )
+  {
+    if ( nev == 0 )
+    {
+      reset_required = true;
+    }
+    else
+    {
+      throw BadProperty( "n_events can only be set to 0." );
+    }
+  }
+  if ( reset_required )
+  {
+    reset();
+  }
+}
+
+void
+nest::spike_count_recorder::State_::add( const State_& s )
+{
+  n_events_ += s.n_events_;
+
+  if ( counts_.size() < s.counts_.size() )
+  {
+    counts_.resize( s.counts_.size(), 0 );
+  }
+  for ( size_t k = 0; k < s.counts_.size(); ++k )
+  {
+    counts_[ k ] += s.counts_[ k ];
+  }
+}
+
+void
+nest::spike_count_recorder::State_::reset()
+{
+  n_events_ = 0;
+  counts_.clear();
+  // keep one count vector for each connected sender
+  neuron_counts_.assign( neuron_counts_.size(), std::vector< long >() );
+}
+
+
+/* ----------------------------------------------------------------
+ * Default and copy constructor for node
+ * ---------------------------------------------------------------- */
+
+nest::spike_count_recorder::spike_count_recorder()
+  : DeviceNode()
+  , device_()
+  , P_()
+  , S_()
+  , senders_()
+  , sender_indices_()
+{
+  if ( not P_.bin_width_.is_step() )
+  {
+    throw InvalidDefaultResolution( get_name(), names::bin_width, P_.bin_width_ );
+  }
+}
+
+nest::spike_count_recorder::spike_count_recorder( const spike_count_recorder& n )
+  : DeviceNode( n )
+  , device_( n.device_ )
+  , P_( n.P_ )
+  , S_()
+  , senders_()
+  , sender_indices_()
+{
+  if ( not P_.bin_width_.is_step() )
+  {
+    throw InvalidTimeInModel( get_name(), names::bin_width, P_.bin_width_ );
+  }
+}
+
+
+/* ----------------------------------------------------------------
+ * Node initialization functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::spike_count_recorder::init_state_( const Node& proto )
+{
+  const spike_count_recorder& pr = downcast< spike_count_recorder >( proto );
+
+  device_.init_state( pr.device_ );
+  S_ = pr.S_;
+}
+
+void
+nest::spike_count_recorder::init_buffers_()
+{
+  device_.init_buffers();
+}
+
+void
+nest::spike_count_recorder::calibrate()
+{
+  device_.calibrate();
+  V_.bin_steps_ = P_.bin_width_.get_steps();
+
+  // one count vector for each sender connected so far
+  S_.neuron_counts_.resize( senders_.size() );
+}
+
+
+/* ----------------------------------------------------------------
+ * Other functions
+ * ---------------------------------------------------------------- */
+
+void
+nest::spike_count_recorder::update( Time const&, const long, const long )
+{
+  // Nothing to do. Counting happens in handle().
+}
+
+nest::port
+nest::spike_count_recorder::handles_test_event( SpikeEvent& e, rport receptor_type )
+{
+  if ( receptor_type != 0 )
+  {
+    throw UnknownReceptorType( receptor_type, get_name() );
+  }
+
+  // the local index of the sender is returned as receiver port of the
+  // connection, so that handle() finds the counts without a lookup
+  const index sender = e.get_sender().get_node_id();
+  std::map< index, rport >::const_iterator it = sender_indices_.find( sender );
+  if ( it != sender_indices_.end() )
+  {
+    return it->second;
+  }
+
+  const rport sender_index = senders_.size();
+  senders_.push_back( sender );
+  sender_indices_[ sender ] = sender_index;
+  return sender_index;
+}
+
+void
+nest::spike_count_recorder::handle( SpikeEvent& e )
+{
+  // accept spikes only if detector was active when spike was emitted
+  if ( device_.is_active( e.get_stamp() ) )
+  {
+    // spike times lie in (t_min, t_max], so the first bin starts at t_min
+    const size_t bin = ( e.get_stamp().get_steps() - device_.get_t_min_() - 1 ) / V_.bin_steps_;
+
+    assert( not P_.per_neuron_ or static_cast< size_t >( e.get_rport() ) < S_.neuron_counts_.size() );
+    std::vector< long >& counts = P_.per_neuron_ ? S_.neuron_counts_[ e.get_rport() ] : S_.counts_;
+    if ( bin >= counts.size() )
+    {
+      counts.resize( bin + 1, 0 );
+    }
+    counts[ bin ] += e.get_multiplicity();
+    S_.n_events_ += e.get_multiplicity();
+  }
+}
+
+void
+nest::spike_count_recorder::get_status( DictionaryDatum& d ) const
+{
+  device_.get_status( d );
+  P_.get( d );
+
+  std::map< index, std::vector< long > > neuron_counts;
+  if ( is_model_prototype() )
+  {
+    S_.get( d, P_, 0, neuron_counts );
+    return; // no data to collect
+  }
+
+  // report all bins that have started before the current time
+  const long t_min = device_.get_t_min_();
+  const long t_max = std::min( kernel().simulation_manager.get_time().get_steps(), device_.get_t_max_() );
+  const long bin_steps = P_.bin_width_.get_steps();
+  const size_t n_bins = t_max > t_min ? ( t_max - t_min + bin_steps - 1 ) / bin_steps : 0;
+
+  collect_neuron_counts_( neuron_counts );
+
+  // if we are the device on thread 0, also sum up the counts from the
+  // siblings on other threads
+  if ( get_thread() == 0 )
+  {
+    State_ total = S_;
+    const std::vector< Node* > siblings = kernel().node_manager.get_thread_siblings( get_node_id() );
+    std::vector< Node* >::const_iterator s;
+    for ( s = siblings.begin() + 1; s != siblings.end(); ++s )
+    {
+      const spike_count_recorder* sibling = dynamic_cast< const spike_count_recorder* >( *s );
+      assert( sibling );
+      total.add( sibling->S_ );
+      sibling->collect_neuron_counts_( neuron_counts );
+    }
+    total.get( d, P_, n_bins, neuron_counts );
+  }
+  else
+  {
+    S_.get( d, P_, n_bins, neuron_counts );
+  }
+}
+
+void
+nest::spike_count_recorder::collect_neuron_counts_( std::map< index, std::vector< long > >& neuron_counts ) const
+{
+  for ( size_t i = 0; i < S_.neuron_counts_.size(); ++i )
+  {
+    // senders without spikes are not reported
+    const std::vector< long >& sender_counts = S_.neuron_counts_[ i ];
+    if ( sender_counts.empty() )
+    {
+      continue;
+    }
+
+    std::vector< long >& total_counts = neuron_counts[ senders_[ i ] ];
+    if ( total_counts.size() < sender_counts.size() )
+    {
+      total_counts.resize( sender_counts.size(), 0 );
+    }
+    for ( size_t k = 0; k < sender_counts.size(); ++k )
+    {
+      total_counts[ k ] += sender_counts[ k ];
+    }
+  }
+}
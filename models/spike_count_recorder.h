@@ -0,0 +1,280 @@
+/*
+ *  spike_count_recorder.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SPIKE_COUNT_RECORDER_H
+#define SPIKE_COUNT_RECORDER_H
+
+// C++ includes:
+#include <map>
+#include <vector>
+
+// Includes from nestkernel:
+#include "device_node.h"
+#include "event.h"
+#include "exceptions.h"
+#include "nest_timeconverter.h"
+#include "nest_types.h"
+#include "pseudo_recording_device.h"
+
+/* BeginUserDocs: device, recorder, spike
+
+Short description
++++++++++++++++++
+
+Counting spikes of neurons in time bins
+
+Description
++++++++++++
+
+The ``spike_count_recorder`` counts the spikes it receives from the
+neurons connected to it in consecutive time bins of width
+``bin_width``. In contrast to the ``spike_recorder``, it does not store
+individual spikes and does not use a recording backend. Recording spike
+counts is thus considerably cheaper if only the time course of the
+firing rate is needed.
+
+By default, the spikes of all neurons are counted together, yielding
+the spike count of the population. If ``per_neuron`` is set, spikes are
+counted separately for each neuron.
+
+Bin ``k`` contains the spikes with times in the interval
+``(origin + start + k * bin_width, origin + start + (k + 1) * bin_width]``.
+The counts are stored in ``counts``, with one entry per bin up to the
+current simulation time. If ``per_neuron`` is set, ``counts`` contains
+one such array for each neuron listed in ``senders``.
+
+Like the ``spike_recorder``, the device keeps one instance per thread,
+which counts the spikes of the neurons on that thread. The counts of
+all threads are summed up when they are read out. Counts are not
+combined across MPI processes.
+
+Each instance numbers the neurons connected to it and uses these numbers
+as receiver ports of the connections. Connections to the device can
+therefore not use the ``_hpc`` synapse models, which only support
+receiver port 0.
+
+::
+
+   >>> neurons = nest.Create('iaf_psc_alpha', 100)
+   >>> scr = nest.Create('spike_count_recorder', params={'bin_width': 5.})
+   >>> nest.Connect(neurons, scr)
+   >>> nest.Simulate(100.)
+   >>> rate = np.array(scr.counts) / (len(neurons) * 5e-3)
+
+Parameters
+++++++++++
+
+========== ======= ========================================================
+bin_width  ms      Width of the time bins, must be a multiple of the
+                   resolution. Changing it clears the counts.
+per_neuron boolean If true, count spikes separately for each neuron.
+                   Changing it clears the counts.
+counts     list    read-only - Spike counts per bin, or list of spike counts
+                   per bin for each sender if per_neuron is set
+senders    list    read-only - Senders for which counts are recorded, only
+                   if per_neuron is set
+n_events   integer Number of spikes counted. Setting n_events to 0 clears
+                   the counts.
+========== ======= ========================================================
+
+Receives
+++++++++
+
+SpikeEvent
+
+See also
+++++++++
+
+spike_recorder
+
+EndUserDocs */
+
+namespace nest
+{
+
+class spike_count_recorder : public DeviceNode
+{
+
+public:
+  spike_count_recorder();
+  spike_count_recorder( const spike_count_recorder& );
+
+  /**
+   * This device has one instance per thread, which receives the spikes
+   * of the neurons on this thread.
+   */
+  bool
+  has_proxies() const
+  {
+    return false;
+  }
+
+  bool
+  local_receiver() const
+  {
+    return true;
+  }
+
+  Name
+  get_element_type() const
+  {
+    return names::recorder;
+  }
+
+  /**
+   * Import sets of overloaded virtual functions.
+   * @see Technical Issues / Virtual Functions: Overriding, Overloading, and
+   * Hiding
+   */
+  using Node::handle;
+  using Node::handles_test_event;
+  using Node::receives_signal;
+
+  void handle( SpikeEvent& );
+
+  port handles_test_event( SpikeEvent&, rport );
+
+  SignalType receives_signal() const;
+
+  void get_status( DictionaryDatum& ) const;
+  void set_status( const DictionaryDatum& );
+
+  void calibrate_time( const TimeConverter& tc );
+
+private:
+  void init_state_( Node const& );
+  void init_buffers_();
+  void calibrate();
+
+  void update( Time const&, const long, const long );
+
+  /**
+   * Add the spike counts per bin of each sender connected to this
+   * instance, by node ID.
+   */
+  void collect_neuron_counts_( std::map< index, std::vector< long > >& ) const;
+
+  // ------------------------------------------------------------
+
+  struct Parameters_
+  {
+    Time bin_width_;  //!< width of the time bins
+    bool per_neuron_; //!< count spikes separately for each neuron
+
+    Parameters_();                     //!< Sets default parameter values
+    Parameters_( const Parameters_& ); //!< Recalibrate all times
+
+    void get( DictionaryDatum& ) const; //!< Store current values in dictionary
+
+    /**
+     * Set values from dictionary.
+     * @returns true if the counts need to be cleared after a change of
+     *          bin_width or per_neuron.
+     */
+    bool set( const DictionaryDatum&, const spike_count_recorder&, Node* );
+  };
+
+  // ------------------------------------------------------------
+
+  /**
+   * @note State_ only contains read-out values, so we copy-construct
+   *       using the default c'tor.
+   */
+  struct State_
+  {
+    long n_events_;              //!< number of spikes counted
+    std::vector< long > counts_; //!< spike counts of all neurons per bin
+
+    //! spike counts per bin of each sender by local sender index, if counted separately
+    std::vector< std::vector< long > > neuron_counts_;
+
+    State_(); //!< initialize default state
+
+    /**
+     * @param n_bins minimal number of bins to report
+     * @param neuron_counts spike counts per bin of each sender by node ID
+     */
+    void get( DictionaryDatum&,
+      const Parameters_&,
+      size_t n_bins,
+      const std::map< index, std::vector< long > >& neuron_counts ) const;
+
+    /**
+     * @param bool if true, force state reset
+     */
+    void set( const DictionaryDatum&, bool, Node* );
+
+    //! Add population counts of the instance of the device on another thread
+    void add( const State_& );
+
+    void reset();
+  };
+
+  // ------------------------------------------------------------
+
+  struct Variables_
+  {
+    long bin_steps_; //!< width of the time bins in steps
+  };
+
+  // ------------------------------------------------------------
+
+  PseudoRecordingDevice device_;
+  Parameters_ P_;
+  State_ S_;
+  Variables_ V_;
+
+  //! node IDs of the senders connected to this instance, by local sender index
+  std::vector< index > senders_;
+
+  //! local sender index of each sender connected to this instance
+  std::map< index, rport > sender_indices_;
+};
+
+inline SignalType
+spike_count_recorder::receives_signal() const
+{
+  return ALL;
+}
+
+inline void
+spike_count_recorder::set_status( const DictionaryDatum& d )
+{
+  Parameters_ ptmp = P_;
+  const bool reset_required = ptmp.set( d, *this, this );
+  State_ stmp = S_;
+  stmp.set( d, reset_required, this );
+
+  device_.set_status( d );
+  P_ = ptmp;
+  S_ = stmp;
+}
+
+inline void
+spike_count_recorder::calibrate_time( const TimeConverter& tc )
+{
+  P_.bin_width_ = tc.from_old_tics( P_.bin_width_.get_tics() );
+}
+
+} // namespace
+
+#endif /* #ifndef SPIKE_COUNT_RECORDER_H */
@@ -22,6 +22,9 @@
 
 #include "spike_generator.h"
 
+// C++ includes:
+#include <algorithm>
+
 // Includes from nestkernel:
 #include "event_delivery_manager_impl.h"
 #include "exceptions.h"
@@ -44,8 +47,7 @@
  * ---------------------------------------------------------------- */
 
 nest::spike_generator::Parameters_::Parameters_()
-  : spike_stamps_()
-  , spike_offsets_()
+  : spike_train_()
   , spike_weights_()
   , spike_multiplicities_()
   , precise_times_( false )
@@ -55,8 +57,7 @@ nest::spike_generator::Parameters_::Parameters_()
 }
 
 nest::spike_generator::Parameters_::Parameters_( const Parameters_& op )
-  : spike_stamps_( op.spike_stamps_ )
-  , spike_offsets_( op.spike_offsets_ )
+  : spike_train_( op.spike_train_ )
   , spike_weights_( op.spike_weights_ )
   , spike_multiplicities_( op.spike_multiplicities_ )
   , precise_times_( op.precise_times_ )
@@ -78,8 +79,8 @@ nest::spike_generator::State_::State_()
 void
 nest::spike_generator::Parameters_::get( DictionaryDatum& d ) const
 {
-  const size_t n_spikes = spike_stamps_.size();
-  const size_t n_offsets = spike_offsets_.size();
+  const size_t n_spikes = spike_train_ ? spike_train_->stamps_.size() : 0;
+  const size_t n_offsets = spike_train_ ? spike_train_->offsets_.size() : 0;
 
   assert( ( precise_times_ && n_offsets == n_spikes ) || ( not precise_times_ && n_offsets == 0 ) );
 
@@ -88,10 +89,10 @@ nest::spike_generator::Parameters_::get( DictionaryDatum& d ) const
   times_ms->reserve( n_spikes );
   for ( size_t n = 0; n < n_spikes; ++n )
   {
-    times_ms->push_back( spike_stamps_[ n ].get_ms() );
+    times_ms->push_back( spike_train_->stamps_[ n ].get_ms() );
     if ( precise_times_ )
     {
-      ( *times_ms )[ n ] -= spike_offsets_[ n ];
+      ( *times_ms )[ n ] -= spike_train_->offsets_[ n ];
     }
   }
   ( *d )[ names::spike_times ] = DoubleVectorDatum( times_ms );
@@ -103,7 +104,10 @@ nest::spike_generator::Parameters_::get( DictionaryDatum& d ) const
 }
 
 void
-nest::spike_generator::Parameters_::assert_valid_spike_time_and_insert_( double t, const Time& origin, const Time& now )
+nest::spike_generator::Parameters_::assert_valid_spike_time_and_insert_( double t,
+  const Time& origin,
+  const Time& now,
+  SpikeTrain_& train ) const
 {
   if ( t == 0.0 && not shift_now_spikes_ )
   {
@@ -146,7 +150,7 @@ nest::spike_generator::Parameters_::assert_valid_spike_time_and_insert_( double
   // t_spike is now the correct time stamp given the chosen options
 
   // when we get here, we know that the spike time is valid
-  spike_stamps_.push_back( t_spike );
+  train.stamps_.push_back( t_spike );
   if ( precise_times_ )
   {
     // t_spike is created with ms_stamp() that aligns the time to the next
@@ -163,10 +167,46 @@ nest::spike_generator::Parameters_::assert_valid_spike_time_and_insert_( double
       offset = 0.0;
     }
     assert( offset >= 0.0 );
-    spike_offsets_.push_back( offset );
+    train.offsets_.push_back( offset );
   }
 }
 
+std::shared_ptr< const nest::spike_generator::SpikeTrain_ >
+nest::spike_generator::Parameters_::build_spike_train_( const std::vector< double >& times,
+  const Time& origin,
+  const Time& now ) const
+{
+  std::shared_ptr< SpikeTrain_ > new_train = std::make_shared< SpikeTrain_ >();
+  new_train->stamps_.reserve( times.size() );
+  if ( precise_times_ )
+  {
+    new_train->offsets_.reserve( times.size() );
+  }
+
+  // Check spike times for ordering and grid compatibility and insert them
+  if ( not times.empty() )
+  {
+    // handle first spike time, no predecessor to compare with
+    std::vector< double >::const_iterator prev = times.begin();
+    assert_valid_spike_time_and_insert_( *prev, origin, now, *new_train );
+
+    // handle all remaining spike times, compare to predecessor
+    for ( std::vector< double >::const_iterator next = prev + 1; next != times.end(); ++next, ++prev )
+    {
+      if ( *prev > *next )
+      {
+        throw BadProperty( "Spike times must be sorted in non-descending order." );
+      }
+      else
+      {
+        assert_valid_spike_time_and_insert_( *next, origin, now, *new_train );
+      }
+    }
+  }
+
+  return new_train;
+}
+
 void
 nest::spike_generator::Parameters_::set( const DictionaryDatum& d,
   State_& s,
@@ -184,8 +224,9 @@ nest::spike_generator::Parameters_::set( const DictionaryDatum& d,
       "allow_offgrid_times or shift_now_spikes is set to true." );
   }
 
+  size_t n_spikes = spike_train_ ? spike_train_->stamps_.size() : 0;
   const bool updated_spike_times = d->known( names::spike_times );
-  if ( flags_changed && not( updated_spike_times || spike_stamps_.empty() ) )
+  if ( flags_changed && not( updated_spike_times || n_spikes == 0 ) )
   {
     throw BadProperty(
       "Options can only be set together with spike times or if no "
@@ -194,36 +235,18 @@ nest::spike_generator::Parameters_::set( const DictionaryDatum& d,
 
   if ( updated_spike_times )
   {
-    const std::vector< double > d_times = getValue< std::vector< double > >( d->lookup( names::spike_times ) );
-    const size_t n_spikes = d_times.size();
-    spike_stamps_.clear();
-    spike_stamps_.reserve( n_spikes );
-    spike_offsets_.clear();
-    if ( precise_times_ )
+    // arrays of doubles are used in place, anything else is converted
+    const Token& t = d->lookup( names::spike_times );
+    DoubleVectorDatum* dvd = dynamic_cast< DoubleVectorDatum* >( t.datum() );
+    if ( dvd )
     {
-      spike_offsets_.reserve( n_spikes );
+      spike_train_ = build_spike_train_( **dvd, origin, now );
     }
-
-    // Check spike times for ordering and grid compatibility and insert them
-    if ( not d_times.empty() )
+    else
     {
-      // handle first spike time, no predecessor to compare with
-      std::vector< double >::const_iterator prev = d_times.begin();
-      assert_valid_spike_time_and_insert_( *prev, origin, now );
-
-      // handle all remaining spike times, compare to predecessor
-      for ( std::vector< double >::const_iterator next = prev + 1; next != d_times.end(); ++next, ++prev )
-      {
-        if ( *prev > *next )
-        {
-          throw BadProperty( "Spike times must be sorted in non-descending order." );
-        }
-        else
-        {
-          assert_valid_spike_time_and_insert_( *next, origin, now );
-        }
-      }
+      spike_train_ = build_spike_train_( getValue< std::vector< double > >( t ), origin, now );
     }
+    n_spikes = spike_train_->stamps_.size();
   }
 
   // spike_weights can be the same size as spike_times, or can be of size 0 to
@@ -239,7 +262,7 @@ nest::spike_generator::Parameters_::set( const DictionaryDatum& d,
     }
     else
     {
-      if ( spike_weights.size() != spike_stamps_.size() )
+      if ( spike_weights.size() != n_spikes )
       {
         throw BadProperty(
           "spike_weights must have the same number of elements as spike_times,"
@@ -264,7 +287,7 @@ nest::spike_generator::Parameters_::set( const DictionaryDatum& d,
     }
     else
     {
-      if ( spike_multiplicities.size() != spike_stamps_.size() )
+      if ( spike_multiplicities.size() != n_spikes )
       {
         throw BadProperty(
           "spike_multiplicities must have the same number of elements as "
@@ -337,30 +360,34 @@ nest::spike_generator::calibrate()
 void
 nest::spike_generator::update( Time const& sliceT0, const long from, const long to )
 {
-  if ( P_.spike_stamps_.empty() )
+  if ( not P_.spike_train_ || P_.spike_train_->stamps_.empty() )
   {
     return;
   }
 
-  assert( not P_.precise_times_ || P_.spike_stamps_.size() == P_.spike_offsets_.size() );
-  assert( P_.spike_weights_.empty() || P_.spike_stamps_.size() == P_.spike_weights_.size() );
-  assert( P_.spike_multiplicities_.empty() || P_.spike_stamps_.size() == P_.spike_multiplicities_.size() );
+  const std::vector< Time >& stamps = P_.spike_train_->stamps_;
+
+  assert( not P_.precise_times_ || stamps.size() == P_.spike_train_->offsets_.size() );
+  assert( P_.spike_weights_.empty() || stamps.size() == P_.spike_weights_.size() );
+  assert( P_.spike_multiplicities_.empty() || stamps.size() == P_.spike_multiplicities_.size() );
 
   const Time tstart = sliceT0 + Time::step( from );
   const Time tstop = sliceT0 + Time::step( to );
   const Time& origin = device_.get_origin();
 
+  // Skip spikes up to including tstart, which happens if spike times or
+  // origin are changed during a simulation; stamps are sorted, so we can
+  // search instead of stepping through them.
+  if ( S_.position_ < stamps.size() && origin + stamps[ S_.position_ ] <= tstart )
+  {
+    S_.position_ = std::upper_bound( stamps.begin() + S_.position_, stamps.end(), tstart - origin ) - stamps.begin();
+  }
+
   // We fire all spikes with time stamps up to including sliceT0 + to
-  while ( S_.position_ < P_.spike_stamps_.size() )
+  while ( S_.position_ < stamps.size() )
   {
-    const Time tnext_stamp = origin + P_.spike_stamps_[ S_.position_ ];
+    const Time tnext_stamp = origin + stamps[ S_.position_ ];
 
-    // this might happen due to wrong usage of the generator
-    if ( tnext_stamp <= tstart )
-    {
-      ++S_.position_;
-      continue;
-    }
     if ( tnext_stamp > tstop )
     {
       break;
@@ -384,7 +411,7 @@ nest::spike_generator::update( Time const& sliceT0, const long from, const long
 
       if ( P_.precise_times_ )
       {
-        se->set_offset( P_.spike_offsets_[ S_.position_ ] );
+        se->set_offset( P_.spike_train_->offsets_[ S_.position_ ] );
       }
 
       if ( not P_.spike_multiplicities_.empty() )
@@ -441,3 +468,13 @@ nest::spike_generator::set_status( const DictionaryDatum& d )
   // if we get here, temporary contains consistent set of properties
   P_ = ptmp;
 }
+
+void
+nest::spike_generator::share_spike_times( const Node& sibling )
+{
+  const spike_generator& sg = downcast< spike_generator >( sibling );
+
+  // instances on all threads have the same options, only the train differs
+  P_.spike_train_ = sg.P_.spike_train_;
+  S_.position_ = 0;
+}
@@ -25,6 +25,7 @@
 
 
 // C++ includes:
+#include <memory>
 #include <vector>
 
 // Includes from nestkernel:
@@ -146,6 +147,17 @@ onto the grid will be handled as follows for different option settings:
 110,
          not shifted, since it is in the future anyways
 
+The converted spike train is not copied when the parameters of a generator
+are copied, e.g., when setting other parameters or creating generators from
+a model with preset spike times. The spike times of many generators can be
+set at once from one NumPy array of times and an array with the offset of
+each generator's times into it, using
+``nest.ll_api.set_spike_generator_times(node_ids, times, offsets)``, or
+``SetSpikeGeneratorTimes`` in SLI. This converts the times of each generator
+only once and shares them between the instances of the generator on all
+threads, while SetStatus converts them on every thread. Generators that are
+given the same spike times do not share them.
+
 Parameters
 ++++++++++
 
@@ -196,6 +208,7 @@ public:
   port send_test_event( Node&, rport, synindex, bool );
   void get_status( DictionaryDatum& ) const;
   void set_status( const DictionaryDatum& );
+  void share_spike_times( const Node& );
 
   /**
    * Import sets of overloaded virtual functions.
@@ -231,13 +244,27 @@ private:
 
   // ------------------------------------------------------------
 
-  struct Parameters_
+  /**
+   * Spike times converted to time stamps and offsets.
+   *
+   * A train is never modified once it has been built, so that copies of
+   * the parameters and the instances of a generator on all threads can
+   * share it.
+   */
+  struct SpikeTrain_
   {
     //! Spike time stamp as Time, rel to origin_
-    std::vector< Time > spike_stamps_;
+    std::vector< Time > stamps_;
 
     //! Spike time offset, if using precise_times_
-    std::vector< double > spike_offsets_;
+    std::vector< double > offsets_;
+
+  };
+
+  struct Parameters_
+  {
+    //! Spike times converted to stamps and offsets, shared by copies and thread instances
+    std::shared_ptr< const SpikeTrain_ > spike_train_;
 
     std::vector< double > spike_weights_; //!< Spike weights as double
 
@@ -266,13 +293,17 @@ private:
     void set( const DictionaryDatum&, State_&, const Time&, const Time&, Node* node );
 
     /**
-     * Insert spike time to arrays, throw BadProperty for invalid spike times.
+     * Build the train for the given spike times with the current options.
+     */
+    std::shared_ptr< const SpikeTrain_ >
+    build_spike_train_( const std::vector< double >&, const Time&, const Time& ) const;
+
+    /**
+     * Insert spike time to train, throw BadProperty for invalid spike times.
      *
      * @param spike time, ms
-     * @param origin
-     * @param current simulation time
      */
-    void assert_valid_spike_time_and_insert_( double, const Time&, const Time& );
+    void assert_valid_spike_time_and_insert_( double, const Time& origin, const Time& now, SpikeTrain_& ) const;
   };
 
   // ------------------------------------------------------------
@@ -431,11 +431,24 @@ nest::Archiving_Node::update_synaptic_elements( double t )
 {
   assert( t >= Ca_t_ );
 
-  for ( std::map< Name, SynapticElement >::iterator it = synaptic_elements_map_.begin();
-        it != synaptic_elements_map_.end();
-        ++it )
+  if ( not synaptic_elements_map_.empty() )
   {
-    it->second.update( t, Ca_t_, Ca_minus_, tau_Ca_ );
+    // integrate the calcium concentration at most once for all synaptic
+    // elements of this node
+    std::vector< double >& Ca_trace = kernel().sp_manager.get_calcium_trace( get_thread() );
+    bool Ca_trace_computed = false;
+
+    for ( std::map< Name, SynapticElement >::iterator it = synaptic_elements_map_.begin();
+          it != synaptic_elements_map_.end();
+          ++it )
+    {
+      if ( not Ca_trace_computed and it->second.uses_calcium_trace() )
+      {
+        GrowthCurve::compute_calcium_trace( t, Ca_t_, Ca_minus_, tau_Ca_, Ca_trace );
+        Ca_trace_computed = true;
+      }
+      it->second.update( t, Ca_t_, Ca_minus_, tau_Ca_, Ca_trace );
+    }
   }
   // Update calcium concentration
   Ca_minus_ = Ca_minus_ * std::exp( ( Ca_t_ - t ) / tau_Ca_ );
@@ -1482,18 +1482,23 @@ nest::FixedTotalNumberBuilder::connect_()
         librandom::RngPtr rng = kernel().rng_manager.get_rng( tid );
 
         // gather local target node IDs
-        std::vector< index > thread_local_targets;
-        thread_local_targets.reserve( number_of_targets_on_vp[ vp_id ] );
+        std::vector< index > thread_local_target_ids;
+        thread_local_target_ids.reserve( number_of_targets_on_vp[ vp_id ] );
 
         std::vector< index >::const_iterator tnode_id_it = local_targets.begin();
         for ( ; tnode_id_it != local_targets.end(); ++tnode_id_it )
         {
           if ( kernel().vp_manager.node_id_to_vp( *tnode_id_it ) == vp_id )
           {
-            thread_local_targets.push_back( *tnode_id_it );
+            thread_local_target_ids.push_back( *tnode_id_it );
           }
         }
 
+        // look up the target nodes once, instead of for every connection
+        std::vector< SparseNodeArray::NodeEntry > thread_local_targets;
+        thread_local_targets.reserve( thread_local_target_ids.size() );
+        kernel().node_manager.get_local_nodes( tid ).filter_local( thread_local_target_ids, thread_local_targets );
+
         assert( thread_local_targets.size() == number_of_targets_on_vp[ vp_id ] );
 
         while ( num_conns_on_vp[ vp_id ] > 0 )
@@ -1509,9 +1514,9 @@ nest::FixedTotalNumberBuilder::connect_()
           const long snode_id = ( *sources_ )[ s_index ];
           // map random number of target node to node ID using the
           // targets_on_vp vector
-          const long tnode_id = thread_local_targets[ t_index ];
+          const long tnode_id = thread_local_targets[ t_index ].get_node_id();
 
-          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          Node* const target = thread_local_targets[ t_index ].get_node();
           const thread target_thread = target->get_thread();
 
           if ( allow_autapses_ or snode_id != tnode_id )
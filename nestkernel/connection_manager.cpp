@@ -48,6 +48,7 @@
 #include "delay_checker.h"
 #include "exceptions.h"
 #include "kernel_manager.h"
+#include "layer.h"
 #include "mpi_manager_impl.h"
 #include "nest_names.h"
 #include "node.h"
@@ -72,6 +73,7 @@ nest::ConnectionManager::ConnectionManager()
   , check_primary_connections_()
   , secondary_connections_exist_( false )
   , check_secondary_connections_()
+  , incremental_update_possible_( false )
   , stdp_eps_( 1.0e-6 )
 {
 }
@@ -129,6 +131,7 @@ nest::ConnectionManager::finalize()
   delete_connections_();
   std::vector< std::vector< ConnectorBase* > >().swap( connections_ );
   std::vector< std::vector< std::vector< size_t > > >().swap( secondary_recv_buffer_pos_ );
+  AbstractLayer::clear_position_caches();
 }
 
 void
@@ -178,6 +181,7 @@ nest::ConnectionManager::get_status( DictionaryDatum& dict )
   def< long >( dict, names::num_connections, n );
   def< bool >( dict, names::keep_source_table, keep_source_table_ );
   def< bool >( dict, names::sort_connections_by_source, sort_connections_by_source_ );
+  def< long >( dict, names::spatial_position_cache_size, AbstractLayer::get_position_cache_size() );
 }
 
 DictionaryDatum
@@ -641,22 +645,22 @@ nest::ConnectionManager::find_connection( const thread tid,
   const index tnode_id )
 {
   // lcid will hold the position of the /first/ connection from node
-  // snode_id to any local node, or be invalid
+  // snode_id to any local node, or be invalid; connections created
+  // since the last sort follow as separate entries
   index lcid = source_table_.find_first_source( tid, syn_id, snode_id );
-  if ( lcid == invalid_index )
+  while ( lcid != invalid_index )
   {
-    return invalid_index;
-  }
-
-  // lcid will hold the position of the /first/ connection from node
-  // snode_id to node tnode_id, or be invalid
-  lcid = connections_[ tid ][ syn_id ]->find_first_target( tid, lcid, tnode_id );
-  if ( lcid != invalid_index )
-  {
-    return lcid;
+    // target_lcid will hold the position of the /first/ connection
+    // from node snode_id to node tnode_id, or be invalid
+    const index target_lcid = connections_[ tid ][ syn_id ]->find_first_target( tid, lcid, tnode_id );
+    if ( target_lcid != invalid_index )
+    {
+      return target_lcid;
+    }
+    lcid = source_table_.find_next_unsorted_source( tid, syn_id, snode_id, lcid );
   }
 
-  return lcid;
+  return invalid_index;
 }
 
 void
@@ -1102,10 +1106,11 @@ nest::ConnectionManager::get_targets( const std::vector< index >& sources,
   {
     for ( size_t i = 0; i < sources.size(); ++i )
     {
-      const index start_lcid = source_table_.find_first_source( tid, syn_id, sources[ i ] );
-      if ( start_lcid != invalid_index )
+      index start_lcid = source_table_.find_first_source( tid, syn_id, sources[ i ] );
+      while ( start_lcid != invalid_index )
       {
         connections_[ tid ][ syn_id ]->get_target_node_ids( tid, start_lcid, post_synaptic_element, targets[ i ] );
+        start_lcid = source_table_.find_next_unsorted_source( tid, syn_id, sources[ i ], start_lcid );
       }
     }
   }
@@ -1125,6 +1130,95 @@ nest::ConnectionManager::sort_connections( const thread tid )
       }
     }
     remove_disabled_connections( tid );
+    source_table_.mark_sources_sorted( tid );
+  }
+}
+
+void
+nest::ConnectionManager::check_incremental_update_possible()
+{
+  bool restructure = secondary_connections_exist_ or not sort_connections_by_source_;
+  for ( thread tid = 0; tid < kernel().vp_manager.get_num_threads(); ++tid )
+  {
+    size_t num_sources;
+    size_t num_unsorted;
+    size_t num_disabled;
+    source_table_.get_num_changed_sources( tid, num_sources, num_unsorted, num_disabled );
+    if ( num_unsorted + num_disabled > max_fraction_changed_connections_ * num_sources )
+    {
+      restructure = true;
+    }
+  }
+
+  incremental_update_possible_ = not kernel().mpi_manager.any_true( restructure );
+}
+
+void
+nest::ConnectionManager::add_targets_of_new_connections()
+{
+  const thread num_processes = kernel().mpi_manager.get_num_processes();
+
+  // each new connection is sent as its source node ID and its
+  // position thread|syn_id|lcid on this rank
+  std::vector< std::vector< index > > new_target_data( num_processes );
+  for ( thread tid = 0; tid < kernel().vp_manager.get_num_threads(); ++tid )
+  {
+    const std::vector< BlockVector< Source > >& sources = source_table_.get_thread_local_sources( tid );
+    for ( synindex syn_id = 0; syn_id < sources.size(); ++syn_id )
+    {
+      for ( index lcid = source_table_.get_num_communicated_sources( tid, syn_id ); lcid < sources[ syn_id ].size();
+            ++lcid )
+      {
+        const Source& source = sources[ syn_id ][ lcid ];
+        if ( source.is_disabled() )
+        {
+          continue;
+        }
+        assert( source.is_primary() );
+
+        std::vector< index >& buffer =
+          new_target_data[ kernel().mpi_manager.get_process_id_of_node_id( source.get_node_id() ) ];
+        buffer.push_back( source.get_node_id() );
+        buffer.push_back( tid );
+        buffer.push_back( syn_id );
+        buffer.push_back( lcid );
+      }
+    }
+    source_table_.mark_sources_communicated( tid );
+  }
+
+  std::vector< index > send_buffer;
+  std::vector< int > send_counts( num_processes );
+  for ( thread rank = 0; rank < num_processes; ++rank )
+  {
+    send_counts[ rank ] = new_target_data[ rank ].size();
+    send_buffer.insert( send_buffer.end(), new_target_data[ rank ].begin(), new_target_data[ rank ].end() );
+  }
+
+  std::vector< index > recv_buffer;
+  std::vector< int > recv_counts;
+  kernel().mpi_manager.communicate_Alltoallv( send_buffer, send_counts, recv_buffer, recv_counts );
+
+  std::vector< index >::const_iterator it = recv_buffer.begin();
+  for ( thread target_rank = 0; target_rank < num_processes; ++target_rank )
+  {
+    for ( int i = 0; i < recv_counts[ target_rank ]; i += 4, it += 4 )
+    {
+      const index source_node_id = *it;
+      const thread source_tid = kernel().vp_manager.vp_to_thread( kernel().vp_manager.node_id_to_vp( source_node_id ) );
+
+      TargetData target_data;
+      target_data.reset_marker();
+      target_data.set_source_lid( kernel().vp_manager.node_id_to_lid( source_node_id ) );
+      target_data.set_source_tid( source_tid );
+      target_data.set_is_primary( true );
+      TargetDataFields& target_fields = target_data.target_data;
+      target_fields.set_tid( *( it + 1 ) );
+      target_fields.set_syn_id( *( it + 2 ) );
+      target_fields.set_lcid( *( it + 3 ) );
+
+      target_table_.add_target( source_tid, target_rank, target_data );
+    }
   }
 }
 
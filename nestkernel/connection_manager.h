@@ -352,6 +352,28 @@ public:
    */
   void restructure_connection_tables( const thread tid );
 
+  /**
+   * Determines on all ranks whether the connections created and
+   * deleted since the last update of the connection infrastructure
+   * can be handled incrementally, i.e., whether few enough
+   * connections are unsorted or disabled and no secondary
+   * connections exist. Otherwise, the connection tables need to be
+   * restructured and sorted.
+   */
+  void check_incremental_update_possible();
+
+  bool incremental_update_possible() const;
+
+  /**
+   * Communicates the connections created since the last update of the
+   * connection infrastructure to the ranks of their sources, where
+   * they are added to the TargetTable. Connections disabled in the
+   * meantime remain in the TargetTable and are skipped during
+   * delivery until the next restructuring. Must be called by a single
+   * thread.
+   */
+  void add_targets_of_new_connections();
+
   void
   set_source_has_more_targets( const thread tid, const synindex syn_id, const index lcid, const bool more_targets );
 
@@ -597,6 +619,15 @@ private:
   //! Check for secondary connections (e.g., gap junctions) on each thread.
   PerThreadBoolIndicator check_secondary_connections_;
 
+  //! Whether new and disabled connections can be handled without
+  //! restructuring the connection tables.
+  bool incremental_update_possible_;
+
+  //! Maximal fraction of unsorted and disabled connections on any
+  //! thread up to which the connection infrastructure is updated
+  //! incrementally.
+  static constexpr double max_fraction_changed_connections_ = 0.1;
+
   //! Maximum distance between (double) spike times in STDP that is
   //! still considered 0. See issue #894
   double stdp_eps_;
@@ -762,6 +793,12 @@ ConnectionManager::secondary_connections_exist() const
   return secondary_connections_exist_;
 }
 
+inline bool
+ConnectionManager::incremental_update_possible() const
+{
+  return incremental_update_possible_;
+}
+
 inline bool
 ConnectionManager::get_sort_connections_by_source() const
 {
@@ -48,19 +48,30 @@ namespace nest
 {
 EventDeliveryManager::EventDeliveryManager()
   : off_grid_spiking_( false )
+  , use_secondary_delta_( false )
+  , secondary_delta_tol_( 0.0 )
+  , secondary_delta_full_exchange_( true )
   , moduli_()
   , slice_moduli_()
   , spike_register_()
   , off_grid_spike_register_()
   , send_buffer_secondary_events_()
   , recv_buffer_secondary_events_()
+  , last_sent_secondary_events_()
+  , send_buffer_secondary_delta_()
+  , recv_buffer_secondary_delta_()
+  , send_counts_secondary_delta_()
+  , recv_counts_secondary_delta_()
   , time_collocate_( 0.0 )
   , time_communicate_( 0.0 )
   , local_spike_counter_()
   , send_buffer_spike_data_()
   , recv_buffer_spike_data_()
-  , send_buffer_off_grid_spike_data_()
-  , recv_buffer_off_grid_spike_data_()
+  , spike_offsets_per_rank_()
+  , send_buffer_spike_offsets_()
+  , recv_buffer_spike_offsets_()
+  , send_counts_spike_offsets_()
+  , recv_counts_spike_offsets_()
   , send_buffer_target_data_()
   , recv_buffer_target_data_()
   , buffer_size_target_data_has_changed_( false )
@@ -86,6 +97,9 @@ EventDeliveryManager::initialize()
   gather_completed_checker_.initialize( num_threads, false );
   // Ensures that ResetKernel resets off_grid_spiking_
   off_grid_spiking_ = false;
+  use_secondary_delta_ = false;
+  secondary_delta_tol_ = 0.0;
+  secondary_delta_full_exchange_ = true;
   buffer_size_target_data_has_changed_ = false;
   buffer_size_spike_data_has_changed_ = false;
 
@@ -110,22 +124,48 @@ EventDeliveryManager::finalize()
 
   send_buffer_secondary_events_.clear();
   recv_buffer_secondary_events_.clear();
+  last_sent_secondary_events_.clear();
+  send_buffer_secondary_delta_.clear();
+  recv_buffer_secondary_delta_.clear();
   send_buffer_spike_data_.clear();
   recv_buffer_spike_data_.clear();
-  send_buffer_off_grid_spike_data_.clear();
-  recv_buffer_off_grid_spike_data_.clear();
+  spike_offsets_per_rank_.clear();
+  send_buffer_spike_offsets_.clear();
+  recv_buffer_spike_offsets_.clear();
 }
 
 void
 EventDeliveryManager::set_status( const DictionaryDatum& dict )
 {
   updateValue< bool >( dict, names::off_grid_spiking, off_grid_spiking_ );
+
+  bool use_secondary_delta;
+  if ( updateValue< bool >( dict, names::use_secondary_delta, use_secondary_delta ) )
+  {
+    // buffers are not persistent in the regular exchange, so the first
+    // delta exchange after switching has to send everything
+    secondary_delta_full_exchange_ =
+      secondary_delta_full_exchange_ or ( use_secondary_delta and not use_secondary_delta_ );
+    use_secondary_delta_ = use_secondary_delta;
+  }
+
+  double secondary_delta_tol;
+  if ( updateValue< double >( dict, names::secondary_delta_tol, secondary_delta_tol ) )
+  {
+    if ( secondary_delta_tol < 0.0 )
+    {
+      throw BadProperty( "secondary_delta_tol must be zero or positive." );
+    }
+    secondary_delta_tol_ = secondary_delta_tol;
+  }
 }
 
 void
 EventDeliveryManager::get_status( DictionaryDatum& dict )
 {
   def< bool >( dict, names::off_grid_spiking, off_grid_spiking_ );
+  def< bool >( dict, names::use_secondary_delta, use_secondary_delta_ );
+  def< double >( dict, names::secondary_delta_tol, secondary_delta_tol_ );
   def< double >( dict, names::time_collocate, time_collocate_ );
   def< double >( dict, names::time_communicate, time_communicate_ );
   def< unsigned long >(
@@ -145,8 +185,9 @@ EventDeliveryManager::resize_send_recv_buffers_spike_data_()
 {
   send_buffer_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
   recv_buffer_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
-  send_buffer_off_grid_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
-  recv_buffer_off_grid_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
+  spike_offsets_per_rank_.resize( kernel().mpi_manager.get_num_processes() );
+  send_counts_spike_offsets_.resize( kernel().mpi_manager.get_num_processes(), 0 );
+  recv_counts_spike_offsets_.resize( kernel().mpi_manager.get_num_processes(), 0 );
 }
 
 void
@@ -157,7 +198,6 @@ EventDeliveryManager::configure_spike_data_buffers()
   configure_spike_register();
 
   send_buffer_spike_data_.clear();
-  send_buffer_off_grid_spike_data_.clear();
 
   resize_send_recv_buffers_spike_data_();
 }
@@ -179,6 +219,9 @@ EventDeliveryManager::configure_secondary_buffers()
   send_buffer_secondary_events_.resize( kernel().mpi_manager.get_buffer_size_secondary_events_in_int() );
   recv_buffer_secondary_events_.clear();
   recv_buffer_secondary_events_.resize( kernel().mpi_manager.get_buffer_size_secondary_events_in_int() );
+  last_sent_secondary_events_.clear();
+  last_sent_secondary_events_.resize( kernel().mpi_manager.get_buffer_size_secondary_events_in_int() );
+  secondary_delta_full_exchange_ = true;
 }
 
 void
@@ -276,8 +319,77 @@ void
 EventDeliveryManager::gather_secondary_events( const bool done )
 {
   write_done_marker_secondary_events_( done );
-  kernel().mpi_manager.communicate_secondary_events_Alltoall(
-    send_buffer_secondary_events_, recv_buffer_secondary_events_ );
+  if ( use_secondary_delta_ )
+  {
+    gather_secondary_events_delta_();
+  }
+  else
+  {
+    kernel().mpi_manager.communicate_secondary_events_Alltoall(
+      send_buffer_secondary_events_, recv_buffer_secondary_events_ );
+  }
+}
+
+void
+EventDeliveryManager::gather_secondary_events_delta_()
+{
+  const size_t chunk_size_in_int = kernel().mpi_manager.get_chunk_size_secondary_events_in_int();
+  const thread num_processes = kernel().mpi_manager.get_num_processes();
+
+  send_buffer_secondary_delta_.clear();
+  send_counts_secondary_delta_.resize( num_processes );
+
+  // collect all entries that differ from the ones sent last; the done
+  // markers are part of the chunks and are handled like any other entry
+  for ( thread rank = 0; rank < num_processes; ++rank )
+  {
+    const size_t begin = rank * chunk_size_in_int;
+    const size_t old_size = send_buffer_secondary_delta_.size();
+    for ( size_t pos = begin; pos < begin + chunk_size_in_int; ++pos )
+    {
+      if ( secondary_delta_full_exchange_
+        or send_buffer_secondary_events_[ pos ] != last_sent_secondary_events_[ pos ] )
+      {
+        send_buffer_secondary_delta_.push_back( pos - begin );
+        send_buffer_secondary_delta_.push_back( send_buffer_secondary_events_[ pos ] );
+        last_sent_secondary_events_[ pos ] = send_buffer_secondary_events_[ pos ];
+      }
+    }
+    send_counts_secondary_delta_[ rank ] = send_buffer_secondary_delta_.size() - old_size;
+  }
+  secondary_delta_full_exchange_ = false;
+
+  kernel().mpi_manager.communicate_Alltoallv( send_buffer_secondary_delta_,
+    send_counts_secondary_delta_,
+    recv_buffer_secondary_delta_,
+    recv_counts_secondary_delta_ );
+
+  // entries that were not received keep the value of the last exchange
+  std::vector< unsigned int >::const_iterator it = recv_buffer_secondary_delta_.begin();
+  for ( thread rank = 0; rank < num_processes; ++rank )
+  {
+    const size_t begin = rank * chunk_size_in_int;
+    const std::vector< unsigned int >::const_iterator end = it + recv_counts_secondary_delta_[ rank ];
+    for ( ; it != end; it += 2 )
+    {
+      recv_buffer_secondary_events_[ begin + *it ] = *( it + 1 );
+    }
+  }
+}
+
+void
+EventDeliveryManager::communicate_spike_offsets_()
+{
+  send_buffer_spike_offsets_.clear();
+  for ( size_t rank = 0; rank < spike_offsets_per_rank_.size(); ++rank )
+  {
+    send_buffer_spike_offsets_.insert(
+      send_buffer_spike_offsets_.end(), spike_offsets_per_rank_[ rank ].begin(), spike_offsets_per_rank_[ rank ].end() );
+    send_counts_spike_offsets_[ rank ] = spike_offsets_per_rank_[ rank ].size();
+  }
+
+  kernel().mpi_manager.communicate_Alltoallv(
+    send_buffer_spike_offsets_, send_counts_spike_offsets_, recv_buffer_spike_offsets_, recv_counts_spike_offsets_ );
 }
 
 bool
@@ -290,14 +402,7 @@ EventDeliveryManager::deliver_secondary_events( const thread tid, const bool cal
 void
 EventDeliveryManager::gather_spike_data( const thread tid )
 {
-  if ( off_grid_spiking_ )
-  {
-    gather_spike_data_( tid, send_buffer_off_grid_spike_data_, recv_buffer_off_grid_spike_data_ );
-  }
-  else
-  {
-    gather_spike_data_( tid, send_buffer_spike_data_, recv_buffer_spike_data_ );
-  }
+  gather_spike_data_( tid, send_buffer_spike_data_, recv_buffer_spike_data_ );
 }
 
 template < typename SpikeDataT >
@@ -331,6 +436,14 @@ EventDeliveryManager::gather_spike_data_( const thread tid,
     SendBufferPosition send_buffer_position(
       assigned_ranks, kernel().mpi_manager.get_send_recv_count_spike_data_per_rank() );
 
+    if ( off_grid_spiking_ )
+    {
+      for ( thread rank = assigned_ranks.begin; rank < assigned_ranks.end; ++rank )
+      {
+        spike_offsets_per_rank_[ rank ].clear();
+      }
+    }
+
     // Collocate spikes to send buffer
     const bool collocate_completed =
       collocate_spike_data_buffers_( tid, assigned_ranks, send_buffer_position, spike_register_, send_buffer );
@@ -361,13 +474,10 @@ EventDeliveryManager::gather_spike_data_( const thread tid,
 // Communicate spikes using a single thread.
 #pragma omp single
     {
+      kernel().mpi_manager.communicate_spike_data_Alltoall( send_buffer, recv_buffer );
       if ( off_grid_spiking_ )
       {
-        kernel().mpi_manager.communicate_off_grid_spike_data_Alltoall( send_buffer, recv_buffer );
-      }
-      else
-      {
-        kernel().mpi_manager.communicate_spike_data_Alltoall( send_buffer, recv_buffer );
+        communicate_spike_offsets_();
       }
     } // of omp single; implicit barrier
 
@@ -441,8 +551,16 @@ EventDeliveryManager::collocate_spike_data_buffers_( const thread tid,
         }
         else
         {
+          const double offset = ( *iiit ).get_offset();
           send_buffer[ send_buffer_position.idx( rank ) ].set(
-            ( *iiit ).get_tid(), ( *iiit ).get_syn_id(), ( *iiit ).get_lcid(), lag, ( *iiit ).get_offset() );
+            ( *iiit ).get_tid(), ( *iiit ).get_syn_id(), ( *iiit ).get_lcid(), lag, offset );
+          // spikes on the grid, including all spikes from grid-based
+          // neurons, are sent without offset
+          if ( offset != 0 )
+          {
+            send_buffer[ send_buffer_position.idx( rank ) ].set_off_grid();
+            spike_offsets_per_rank_[ rank ].push_back( offset );
+          }
           ( *iiit ).set_status( TARGET_ID_PROCESSED ); // mark entry for removal
           send_buffer_position.increase( rank );
         }
@@ -533,6 +651,9 @@ EventDeliveryManager::deliver_events_( const thread tid, const std::vector< Spik
     prepared_timestamps[ lag ] = kernel().simulation_manager.get_clock() + Time::step( lag + 1 );
   }
 
+  // position of the offset of the next off-grid spike
+  std::vector< double >::const_iterator offset_it = recv_buffer_spike_offsets_.begin();
+
   for ( thread rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
   {
     // check last entry for completed marker; needs to be done before
@@ -552,10 +673,19 @@ EventDeliveryManager::deliver_events_( const thread tid, const std::vector< Spik
     {
       const SpikeDataT& spike_data = recv_buffer[ rank * send_recv_count_spike_data_per_rank + i ];
 
+      // offsets of all off-grid spikes are received, irrespective of the
+      // thread they are delivered by
+      double offset = 0;
+      if ( spike_data.is_off_grid() )
+      {
+        offset = *offset_it;
+        ++offset_it;
+      }
+
       if ( spike_data.get_tid() == tid )
       {
         se.set_stamp( prepared_timestamps[ spike_data.get_lag() ] );
-        se.set_offset( spike_data.get_offset() );
+        se.set_offset( offset );
 
         const index syn_id = spike_data.get_syn_id();
         const index lcid = spike_data.get_lcid();
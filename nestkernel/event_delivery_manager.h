@@ -25,6 +25,7 @@
 
 // C++ includes:
 #include <cassert>
+#include <cmath>
 #include <limits>
 #include <vector>
 
@@ -83,6 +84,18 @@ public:
    */
   void send_secondary( Node& source, SecondaryEvent& e );
 
+  /**
+   * Returns whether the payload new_values of a secondary event has to be
+   * sent. If use_secondary_delta is set, this is only the case if
+   * new_values differs from last_sent by more than secondary_delta_tol,
+   * or if the next exchange sends all entries, e.g., after the delta mode
+   * has been switched on again; otherwise the receivers keep the value sent
+   * last. last_sent is updated whenever true is returned. Nodes must clear
+   * last_sent in init_buffers_() to enforce sending the complete payload at
+   * the beginning of a simulation.
+   */
+  bool secondary_payload_changed( std::vector< double >& last_sent, const std::vector< double >& new_values ) const;
+
   /**
    * Send event e to all targets of node source on thread t
    */
@@ -243,9 +256,23 @@ private:
 
   void resize_send_recv_buffers_spike_data_();
 
+  /**
+   * Communicates only those entries of the secondary send buffer that
+   * changed since the last exchange as (offset, value) pairs and writes
+   * them into the persistent secondary receive buffer.
+   */
+  void gather_secondary_events_delta_();
+
+  /**
+   * Communicates the offsets of all off-grid spikes in the current
+   * spike send buffer.
+   */
+  void communicate_spike_offsets_();
+
   /**
    * Moves spikes from on grid and off grid spike registers to correct
-   * locations in MPI buffers.
+   * locations in MPI buffers. Spikes with non-zero offset are flagged as
+   * off-grid and their offsets collected per target rank.
    */
   template < typename TargetT, typename SpikeDataT >
   bool collocate_spike_data_buffers_( const thread tid,
@@ -350,6 +377,11 @@ private:
   bool off_grid_spiking_; //!< indicates whether spikes are not constrained to
                           //!< the grid
 
+  bool use_secondary_delta_;           //!< only send changed secondary events
+  double secondary_delta_tol_;         //!< tolerance below which secondary
+                                       //!< event payloads count as unchanged
+  bool secondary_delta_full_exchange_; //!< send all entries in next exchange
+
   /**
    * Table of pre-computed modulos.
    * This table is used to map time steps, given as offset from now,
@@ -392,7 +424,7 @@ private:
    * - First dim: write threads (from node to register)
    * - Second dim: read threads (from register to MPI buffer)
    * - Third dim: lag
-   * - Fourth dim: OffGridTarget (will be converted in OffGridSpikeData)
+   * - Fourth dim: OffGridTarget (will be converted in SpikeData and offset)
    */
   std::vector< std::vector< std::vector< std::vector< OffGridTarget > > > > off_grid_spike_register_;
 
@@ -403,6 +435,17 @@ private:
   std::vector< unsigned int > send_buffer_secondary_events_;
   std::vector< unsigned int > recv_buffer_secondary_events_;
 
+  /**
+   * Buffers for the delta exchange of secondary events: copy of the send
+   * buffer at the last exchange, (offset, value) pairs to send and receive,
+   * and the number of entries per rank.
+   */
+  std::vector< unsigned int > last_sent_secondary_events_;
+  std::vector< unsigned int > send_buffer_secondary_delta_;
+  std::vector< unsigned int > recv_buffer_secondary_delta_;
+  std::vector< int > send_counts_secondary_delta_;
+  std::vector< int > recv_counts_secondary_delta_;
+
   /**
    * Time that was spent on collocation of MPI buffers during the last call to
    * simulate.
@@ -423,8 +466,18 @@ private:
 
   std::vector< SpikeData > send_buffer_spike_data_;
   std::vector< SpikeData > recv_buffer_spike_data_;
-  std::vector< OffGridSpikeData > send_buffer_off_grid_spike_data_;
-  std::vector< OffGridSpikeData > recv_buffer_off_grid_spike_data_;
+
+  /**
+   * Offsets of off-grid spikes, collected per target rank by the thread
+   * assigned to the rank, and buffers to exchange them. Offsets follow the
+   * order of the off-grid entries in the spike data buffers, so that only
+   * spikes from precise neurons add to the communicated data.
+   */
+  std::vector< std::vector< double > > spike_offsets_per_rank_;
+  std::vector< double > send_buffer_spike_offsets_;
+  std::vector< double > recv_buffer_spike_offsets_;
+  std::vector< int > send_counts_spike_offsets_;
+  std::vector< int > recv_counts_spike_offsets_;
 
   std::vector< TargetData > send_buffer_target_data_;
   std::vector< TargetData > recv_buffer_target_data_;
@@ -512,6 +565,31 @@ EventDeliveryManager::set_off_grid_communication( bool off_grid_spiking )
   off_grid_spiking_ = off_grid_spiking;
 }
 
+inline bool
+EventDeliveryManager::secondary_payload_changed( std::vector< double >& last_sent,
+  const std::vector< double >& new_values ) const
+{
+  if ( not use_secondary_delta_ )
+  {
+    return true;
+  }
+
+  // last_sent is not updated while the delta mode is off and the send
+  // buffer may have been reconfigured, so all nodes write their payload
+  // before a full exchange
+  bool changed = secondary_delta_full_exchange_ or last_sent.size() != new_values.size();
+  for ( size_t i = 0; i < new_values.size() and not changed; ++i )
+  {
+    changed = std::abs( new_values[ i ] - last_sent[ i ] ) > secondary_delta_tol_;
+  }
+
+  if ( changed )
+  {
+    last_sent = new_values;
+  }
+  return changed;
+}
+
 inline size_t
 EventDeliveryManager::read_toggle() const
 {
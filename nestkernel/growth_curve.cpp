@@ -39,6 +39,30 @@
 // Includes from sli:
 #include "dictutils.h"
 
+/* ----------------------------------------------------------------
+ * GrowthCurve
+ * ---------------------------------------------------------------- */
+
+void
+nest::GrowthCurve::compute_calcium_trace( double t,
+  double t_minus,
+  double Ca_minus,
+  double tau_Ca,
+  std::vector< double >& Ca_trace )
+{
+  // use standard forward Euler numerics
+  const double h = Time::get_resolution().get_ms();
+
+  Ca_trace.clear();
+  double Ca = Ca_minus;
+
+  for ( double lag = t_minus; lag < ( t - h / 2.0 ); lag += h )
+  {
+    Ca = Ca - ( ( Ca / tau_Ca ) * h );
+    Ca_trace.push_back( Ca );
+  }
+}
+
 /* ----------------------------------------------------------------
  * GrowthCurveLinear
  * ---------------------------------------------------------------- */
@@ -110,19 +134,30 @@ nest::GrowthCurveGaussian::update( double t,
   double tau_Ca,
   double growth_rate ) const
 {
-  // Numerical integration from t_minus to t
-  // use standard forward Euler numerics
+  std::vector< double > Ca_trace;
+  compute_calcium_trace( t, t_minus, Ca_minus, tau_Ca, Ca_trace );
+  return update( t, t_minus, Ca_minus, z_minus, tau_Ca, growth_rate, Ca_trace );
+}
+
+double
+nest::GrowthCurveGaussian::update( double,
+  double,
+  double,
+  double z_minus,
+  double,
+  double growth_rate,
+  const std::vector< double >& Ca_trace ) const
+{
+  // Numerical integration from t_minus to t along the calcium trace
   const double h = Time::get_resolution().get_ms();
   const double zeta = ( eta_ - eps_ ) / ( 2.0 * sqrt( log( 2.0 ) ) );
   const double xi = ( eta_ + eps_ ) / 2.0;
 
   double z_value = z_minus;
-  double Ca = Ca_minus;
 
-  for ( double lag = t_minus; lag < ( t - h / 2.0 ); lag += h )
+  for ( std::vector< double >::const_iterator Ca = Ca_trace.begin(); Ca != Ca_trace.end(); ++Ca )
   {
-    Ca = Ca - ( ( Ca / tau_Ca ) * h );
-    const double dz = h * growth_rate * ( 2.0 * exp( -pow( ( Ca - xi ) / zeta, 2 ) ) - 1.0 );
+    const double dz = h * growth_rate * ( 2.0 * exp( -pow( ( *Ca - xi ) / zeta, 2 ) ) - 1.0 );
     z_value = z_value + dz;
   }
 
@@ -169,17 +204,28 @@ nest::GrowthCurveSigmoid::update( double t,
   double tau_Ca,
   double growth_rate ) const
 {
-  // Numerical integration from t_minus to t
-  // use standard forward Euler numerics
+  std::vector< double > Ca_trace;
+  compute_calcium_trace( t, t_minus, Ca_minus, tau_Ca, Ca_trace );
+  return update( t, t_minus, Ca_minus, z_minus, tau_Ca, growth_rate, Ca_trace );
+}
+
+double
+nest::GrowthCurveSigmoid::update( double,
+  double,
+  double,
+  double z_minus,
+  double,
+  double growth_rate,
+  const std::vector< double >& Ca_trace ) const
+{
+  // Numerical integration from t_minus to t along the calcium trace
   const double h = Time::get_resolution().get_ms();
 
   double z_value = z_minus;
-  double Ca = Ca_minus;
 
-  for ( double lag = t_minus; lag < ( t - h / 2.0 ); lag += h )
+  for ( std::vector< double >::const_iterator Ca = Ca_trace.begin(); Ca != Ca_trace.end(); ++Ca )
   {
-    Ca = Ca - ( ( Ca / tau_Ca ) * h );
-    const double dz = h * growth_rate * ( ( 2.0 / ( 1.0 + exp( ( Ca - eps_ ) / psi_ ) ) ) - 1.0 );
+    const double dz = h * growth_rate * ( ( 2.0 / ( 1.0 + exp( ( *Ca - eps_ ) / psi_ ) ) ) - 1.0 );
     z_value = z_value + dz;
   }
 
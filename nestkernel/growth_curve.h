@@ -30,6 +30,9 @@
  * \date July 2013
  */
 
+// C++ includes:
+#include <vector>
+
 // Includes from nestkernel:
 #include "nest_types.h"
 #include "exceptions.h"
@@ -55,6 +58,48 @@ public:
   virtual void set( const DictionaryDatum& d ) = 0;
   virtual double
   update( double t, double t_minus, double Ca_minus, double z, double tau_Ca, double growth_rate ) const = 0;
+
+  /**
+   * Update the number of synaptic elements using a calcium trace
+   * precomputed by compute_calcium_trace(). Nodes compute the trace once
+   * and share it between all their synaptic elements whose growth curve
+   * uses it, instead of integrating the calcium concentration anew for
+   * every element. Growth curves which do not integrate the calcium
+   * concentration numerically ignore the trace.
+   */
+  virtual double
+  update( double t,
+    double t_minus,
+    double Ca_minus,
+    double z,
+    double tau_Ca,
+    double growth_rate,
+    const std::vector< double >& ) const
+  {
+    return update( t, t_minus, Ca_minus, z, tau_Ca, growth_rate );
+  }
+
+  /**
+   * Return true if update() integrates the calcium concentration
+   * numerically and thus benefits from a precomputed calcium trace.
+   */
+  virtual bool
+  uses_calcium_trace() const
+  {
+    return false;
+  }
+
+  /**
+   * Integrate the calcium concentration from t_minus to t with forward
+   * Euler steps of the simulation resolution. Ca_trace holds the
+   * concentration after each step.
+   */
+  static void compute_calcium_trace( double t,
+    double t_minus,
+    double Ca_minus,
+    double tau_Ca,
+    std::vector< double >& Ca_trace );
+
   virtual bool
   is( Name n )
   {
@@ -133,6 +178,7 @@ public:
   GrowthCurveLinear();
   void get( DictionaryDatum& d ) const;
   void set( const DictionaryDatum& d );
+  using GrowthCurve::update;
   double update( double t, double t_minus, double Ca_minus, double z, double tau_Ca, double growth_rate ) const;
 
 private:
@@ -221,6 +267,18 @@ public:
   void get( DictionaryDatum& d ) const;
   void set( const DictionaryDatum& d );
   double update( double t, double t_minus, double Ca_minus, double z, double tau_Ca, double growth_rate ) const;
+  double update( double t,
+    double t_minus,
+    double Ca_minus,
+    double z,
+    double tau_Ca,
+    double growth_rate,
+    const std::vector< double >& Ca_trace ) const;
+  bool
+  uses_calcium_trace() const
+  {
+    return true;
+  }
 
 private:
   double eta_;
@@ -293,6 +351,18 @@ public:
   void get( DictionaryDatum& d ) const;
   void set( const DictionaryDatum& d );
   double update( double t, double t_minus, double Ca_minus, double z, double tau_Ca, double growth_rate ) const;
+  double update( double t,
+    double t_minus,
+    double Ca_minus,
+    double z,
+    double tau_Ca,
+    double growth_rate,
+    const std::vector< double >& Ca_trace ) const;
+  bool
+  uses_calcium_trace() const
+  {
+    return true;
+  }
 
 private:
   double eps_;
@@ -40,6 +40,7 @@
 // Includes from nestkernel:
 #include "kernel_manager.h"
 #include "recording_backend_ascii.h"
+#include "recording_backend_binary.h"
 #include "recording_backend_memory.h"
 #include "recording_backend_screen.h"
 #ifdef HAVE_RECORDINGBACKEND_ARBOR
@@ -260,6 +261,16 @@ IOManager::write( Name backend_name,
   recording_backends_[ backend_name ]->write( device, event, double_values, long_values );
 }
 
+void
+IOManager::write_samples( Name backend_name,
+  const RecordingDevice& device,
+  DataLoggingReply& reply,
+  size_t begin,
+  size_t end )
+{
+  recording_backends_[ backend_name ]->write_samples( device, reply, begin, end );
+}
+
 void
 IOManager::enroll_recorder( Name backend_name, const RecordingDevice& device, const DictionaryDatum& params )
 {
@@ -307,6 +318,7 @@ void
 IOManager::register_recording_backends_()
 {
   recording_backends_.insert( std::make_pair( "ascii", new RecordingBackendASCII() ) );
+  recording_backends_.insert( std::make_pair( "binary", new RecordingBackendBinary() ) );
   recording_backends_.insert( std::make_pair( "memory", new RecordingBackendMemory() ) );
   recording_backends_.insert( std::make_pair( "screen", new RecordingBackendScreen() ) );
 #ifdef HAVE_RECORDINGBACKEND_ARBOR
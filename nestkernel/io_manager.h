@@ -101,6 +101,8 @@ public:
 
   void write( Name, const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& );
 
+  void write_samples( Name, const RecordingDevice&, DataLoggingReply&, size_t, size_t );
+
   void enroll_recorder( Name, const RecordingDevice&, const DictionaryDatum& );
 
   void set_recording_value_names( Name backend_name,
@@ -732,6 +732,93 @@ nest::MPIManager::communicate_secondary_events_Alltoall_( void* send_buffer, voi
     comm );
 }
 
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< unsigned int >& send_buffer,
+  std::vector< int >& send_counts,
+  std::vector< unsigned int >& recv_buffer,
+  std::vector< int >& recv_counts )
+{
+  recv_counts.resize( get_num_processes() );
+  MPI_Alltoall( &send_counts[ 0 ], 1, MPI_INT, &recv_counts[ 0 ], 1, MPI_INT, comm );
+
+  std::vector< int > send_displacements( get_num_processes(), 0 );
+  std::vector< int > recv_displacements( get_num_processes(), 0 );
+  for ( int i = 1; i < get_num_processes(); ++i )
+  {
+    send_displacements[ i ] = send_displacements[ i - 1 ] + send_counts[ i - 1 ];
+    recv_displacements[ i ] = recv_displacements[ i - 1 ] + recv_counts[ i - 1 ];
+  }
+  recv_buffer.resize( recv_displacements[ get_num_processes() - 1 ] + recv_counts[ get_num_processes() - 1 ] );
+
+  MPI_Alltoallv( send_buffer.data(),
+    &send_counts[ 0 ],
+    &send_displacements[ 0 ],
+    MPI_UNSIGNED,
+    recv_buffer.data(),
+    &recv_counts[ 0 ],
+    &recv_displacements[ 0 ],
+    MPI_UNSIGNED,
+    comm );
+}
+
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< unsigned long >& send_buffer,
+  std::vector< int >& send_counts,
+  std::vector< unsigned long >& recv_buffer,
+  std::vector< int >& recv_counts )
+{
+  recv_counts.resize( get_num_processes() );
+  MPI_Alltoall( &send_counts[ 0 ], 1, MPI_INT, &recv_counts[ 0 ], 1, MPI_INT, comm );
+
+  std::vector< int > send_displacements( get_num_processes(), 0 );
+  std::vector< int > recv_displacements( get_num_processes(), 0 );
+  for ( int i = 1; i < get_num_processes(); ++i )
+  {
+    send_displacements[ i ] = send_displacements[ i - 1 ] + send_counts[ i - 1 ];
+    recv_displacements[ i ] = recv_displacements[ i - 1 ] + recv_counts[ i - 1 ];
+  }
+  recv_buffer.resize( recv_displacements[ get_num_processes() - 1 ] + recv_counts[ get_num_processes() - 1 ] );
+
+  MPI_Alltoallv( send_buffer.data(),
+    &send_counts[ 0 ],
+    &send_displacements[ 0 ],
+    MPI_UNSIGNED_LONG,
+    recv_buffer.data(),
+    &recv_counts[ 0 ],
+    &recv_displacements[ 0 ],
+    MPI_UNSIGNED_LONG,
+    comm );
+}
+
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< double >& send_buffer,
+  std::vector< int >& send_counts,
+  std::vector< double >& recv_buffer,
+  std::vector< int >& recv_counts )
+{
+  recv_counts.resize( get_num_processes() );
+  MPI_Alltoall( &send_counts[ 0 ], 1, MPI_INT, &recv_counts[ 0 ], 1, MPI_INT, comm );
+
+  std::vector< int > send_displacements( get_num_processes(), 0 );
+  std::vector< int > recv_displacements( get_num_processes(), 0 );
+  for ( int i = 1; i < get_num_processes(); ++i )
+  {
+    send_displacements[ i ] = send_displacements[ i - 1 ] + send_counts[ i - 1 ];
+    recv_displacements[ i ] = recv_displacements[ i - 1 ] + recv_counts[ i - 1 ];
+  }
+  recv_buffer.resize( recv_displacements[ get_num_processes() - 1 ] + recv_counts[ get_num_processes() - 1 ] );
+
+  MPI_Alltoallv( send_buffer.data(),
+    &send_counts[ 0 ],
+    &send_displacements[ 0 ],
+    MPI_DOUBLE,
+    recv_buffer.data(),
+    &recv_counts[ 0 ],
+    &recv_displacements[ 0 ],
+    MPI_DOUBLE,
+    comm );
+}
+
 /**
  * Ensure all processes have reached the same stage by waiting until all
  * processes have sent a dummy message to process 0.
@@ -1067,4 +1154,34 @@ nest::MPIManager::communicate_Allreduce_max_in_place( std::vector< long >& buffe
   // Max already is the input
 }
 
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< unsigned int >& send_buffer,
+  std::vector< int >& send_counts,
+  std::vector< unsigned int >& recv_buffer,
+  std::vector< int >& recv_counts )
+{
+  recv_counts = send_counts;
+  recv_buffer.swap( send_buffer );
+}
+
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< unsigned long >& send_buffer,
+  std::vector< int >& send_counts,
+  std::vector< unsigned long >& recv_buffer,
+  std::vector< int >& recv_counts )
+{
+  recv_counts = send_counts;
+  recv_buffer.swap( send_buffer );
+}
+
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< double >& send_buffer,
+  std::vector< int >& send_counts,
+  std::vector< double >& recv_buffer,
+  std::vector< int >& recv_counts )
+{
+  recv_counts = send_counts;
+  recv_buffer.swap( send_buffer );
+}
+
 #endif /* #ifdef HAVE_MPI */
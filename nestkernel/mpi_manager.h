@@ -166,6 +166,26 @@ public:
    */
   void communicate_Allreduce_max_in_place( std::vector< long >& buffer );
 
+  /*
+   * Exchange messages of variable length between all ranks. The entries
+   * of send_buffer destined for each rank are stored contiguously in rank
+   * order, their number is given by send_counts. On return, recv_buffer
+   * holds the received entries in rank order and recv_counts their number
+   * per rank.
+   */
+  void communicate_Alltoallv( std::vector< unsigned int >& send_buffer,
+    std::vector< int >& send_counts,
+    std::vector< unsigned int >& recv_buffer,
+    std::vector< int >& recv_counts );
+  void communicate_Alltoallv( std::vector< unsigned long >& send_buffer,
+    std::vector< int >& send_counts,
+    std::vector< unsigned long >& recv_buffer,
+    std::vector< int >& recv_counts );
+  void communicate_Alltoallv( std::vector< double >& send_buffer,
+    std::vector< int >& send_counts,
+    std::vector< double >& recv_buffer,
+    std::vector< int >& recv_counts );
+
   std::string get_processor_name();
 
   bool is_mpi_used();
@@ -210,8 +230,6 @@ public:
   template < class D >
   void communicate_spike_data_Alltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer );
   template < class D >
-  void communicate_off_grid_spike_data_Alltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer );
-  template < class D >
   void communicate_secondary_events_Alltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer );
 
   void synchronize();
@@ -710,16 +728,6 @@ MPIManager::communicate_spike_data_Alltoall( std::vector< D >& send_buffer, std:
 
   communicate_Alltoall( send_buffer, recv_buffer, send_recv_count_spike_data_in_int_per_rank );
 }
-
-template < class D >
-void
-MPIManager::communicate_off_grid_spike_data_Alltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer )
-{
-  const size_t send_recv_count_off_grid_spike_data_in_int_per_rank =
-    sizeof( OffGridSpikeData ) / sizeof( unsigned int ) * send_recv_count_spike_data_per_rank_;
-
-  communicate_Alltoall( send_buffer, recv_buffer, send_recv_count_off_grid_spike_data_in_int_per_rank );
-}
 }
 
 #endif /* MPI_MANAGER_H */
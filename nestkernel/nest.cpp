@@ -312,6 +312,94 @@ connect_arrays( long* sources,
   }
 }
 
+void
+set_spike_generator_times( long* node_ids, size_t n, double* times, long* offsets )
+{
+  for ( size_t i = 0; i < n; ++i )
+  {
+    if ( 0 >= node_ids[ i ] or static_cast< index >( node_ids[ i ] ) > kernel().node_manager.size() )
+    {
+      throw UnknownNode( node_ids[ i ] );
+    }
+    if ( kernel().node_manager.get_node_or_proxy( node_ids[ i ], 0 )->has_proxies() )
+    {
+      throw BadParameter( "Spike times can only be set for spike generators." );
+    }
+    if ( offsets[ i ] < 0 or offsets[ i ] > offsets[ i + 1 ] )
+    {
+      throw BadParameter( "Offsets into the spike times must be non-negative and sorted." );
+    }
+  }
+
+  const thread num_threads = kernel().vp_manager.get_num_threads();
+
+  // Vector for storing exceptions raised by threads.
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( num_threads );
+#pragma omp parallel
+  {
+    const auto tid = kernel().vp_manager.get_thread_id();
+
+    // Generators have an instance on every thread. The times of each
+    // generator are converted once, by the instance on thread i % num_threads.
+    try
+    {
+      for ( size_t i = tid; i < n; i += num_threads )
+      {
+        DictionaryDatum d( new Dictionary() );
+        ( *d )[ names::spike_times ] =
+          DoubleVectorDatum( new std::vector< double >( times + offsets[ i ], times + offsets[ i + 1 ] ) );
+        kernel().node_manager.get_node_or_proxy( node_ids[ i ], tid )->set_status_base( d );
+        ALL_ENTRIES_ACCESSED( *d, "set_spike_generator_times", "Unread dictionary entries: " );
+      }
+    }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at the end of the catch block.
+      exceptions_raised.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+
+#pragma omp barrier
+
+    // The instances on all other threads share the converted times, unless
+    // converting failed for any generator.
+    bool converted = true;
+    for ( thread t = 0; t < num_threads; ++t )
+    {
+      converted = converted and not exceptions_raised.at( t ).get();
+    }
+
+#pragma omp barrier
+
+    if ( converted )
+    {
+      try
+      {
+        for ( size_t i = 0; i < n; ++i )
+        {
+          const thread converting_tid = i % num_threads;
+          if ( converting_tid != tid )
+          {
+            Node* node = kernel().node_manager.get_node_or_proxy( node_ids[ i ], tid );
+            node->share_spike_times( *kernel().node_manager.get_node_or_proxy( node_ids[ i ], converting_tid ) );
+          }
+        }
+      }
+      catch ( std::exception& err )
+      {
+        exceptions_raised.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+      }
+    }
+  }
+  // check if any exceptions have been raised
+  for ( thread tid = 0; tid < num_threads; ++tid )
+  {
+    if ( exceptions_raised.at( tid ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised.at( tid ) ) );
+    }
+  }
+}
+
 ArrayDatum
 get_connections( const DictionaryDatum& dict )
 {
@@ -143,6 +143,18 @@ void connect_arrays( long* sources,
   size_t n,
   std::string syn_model );
 
+/**
+ * @brief Set the spike times of many spike generators from one array
+ *
+ * The spike times of all n generators given by node_ids are stored one
+ * after the other in the array times. The spike times of generator
+ * node_ids[ i ] are the elements from times[ offsets[ i ] ] up to
+ * excluding times[ offsets[ i + 1 ] ], so that offsets has n + 1 elements.
+ * The times of each generator are converted once, on one thread, and
+ * the instances of the generator on all threads share the result.
+ */
+void set_spike_generator_times( long* node_ids, size_t n, double* times, long* offsets );
+
 ArrayDatum get_connections( const DictionaryDatum& dict );
 
 void simulate( const double& t );
@@ -52,6 +52,7 @@ const Name adapting_threshold( "adapting_threshold" );
 const Name adaptive_spike_buffers( "adaptive_spike_buffers" );
 const Name adaptive_target_buffers( "adaptive_target_buffers" );
 const Name after_spike_currents( "after_spike_currents" );
+const Name aggregation( "aggregation" );
 const Name ahp_bug( "ahp_bug" );
 const Name allow_autapses( "allow_autapses" );
 const Name allow_multapses( "allow_multapses" );
@@ -75,6 +76,7 @@ const Name azimuth_angle( "azimuth_angle" );
 const Name b( "b" );
 const Name beta( "beta" );
 const Name beta_Ca( "beta_Ca" );
+const Name bin_width( "bin_width" );
 const Name box( "box" );
 const Name buffer_size( "buffer_size" );
 const Name buffer_size_secondary_events( "buffer_size_secondary_events" );
@@ -91,6 +93,7 @@ const Name capacity( "capacity" );
 const Name center( "center" );
 const Name circular( "circular" );
 const Name clear( "clear" );
+const Name clear_events( "clear_events" );
 const Name comparator( "comparator" );
 const Name configbit_0( "configbit_0" );
 const Name configbit_1( "configbit_1" );
@@ -100,6 +103,7 @@ const Name consistent_integration( "consistent_integration" );
 const Name continuous( "continuous" );
 const Name count_covariance( "count_covariance" );
 const Name count_histogram( "count_histogram" );
+const Name counts( "counts" );
 const Name covariance( "covariance" );
 
 const Name Delta_T( "Delta_T" );
@@ -281,6 +285,7 @@ const Name message_times( "messages_times" );
 const Name messages( "messages" );
 const Name min( "min" );
 const Name min_delay( "min_delay" );
+const Name min_max( "min_max" );
 const Name minor_axis( "minor_axis" );
 const Name model( "model" );
 const Name mother_rng( "mother_rng" );
@@ -298,6 +303,7 @@ const Name N_channels( "N_channels" );
 const Name n( "n" );
 const Name n_events( "n_events" );
 const Name n_messages( "n_messages" );
+const Name n_neurons( "n_neurons" );
 const Name n_proc( "n_proc" );
 const Name n_receptors( "n_receptors" );
 const Name n_synapses( "n_synapses" );
@@ -308,6 +314,7 @@ const Name no_synapses( "no_synapses" );
 const Name node_uses_wfr( "node_uses_wfr" );
 const Name noise( "noise" );
 const Name noisy_rate( "noisy_rate" );
+const Name none( "none" );
 const Name num_connections( "num_connections" );
 const Name num_processes( "num_processes" );
 const Name number_of_connections( "number_of_connections" );
@@ -329,6 +336,7 @@ const Name p_copy( "p_copy" );
 const Name p_transmit( "p_transmit" );
 const Name pairwise_bernoulli_on_source( "pairwise_bernoulli_on_source" );
 const Name pairwise_bernoulli_on_target( "pairwise_bernoulli_on_target" );
+const Name per_neuron( "per_neuron" );
 const Name phase( "phase" );
 const Name phi_max( "phi_max" );
 const Name polar_angle( "polar_angle" );
@@ -388,6 +396,7 @@ const Name S( "S" );
 const Name S_act_NMDA( "S_act_NMDA" );
 const Name scale( "scale" );
 const Name sdev( "sdev" );
+const Name secondary_delta_tol( "secondary_delta_tol" );
 const Name senders( "senders" );
 const Name shape( "shape" );
 const Name shift_now_spikes( "shift_now_spikes" );
@@ -402,6 +411,8 @@ const Name soma_exc( "soma_exc" );
 const Name soma_inh( "soma_inh" );
 const Name sort_connections_by_source( "sort_connections_by_source" );
 const Name source( "source" );
+const Name spatial_index( "spatial_index" );
+const Name spatial_position_cache_size( "spatial_position_cache_size" );
 const Name spherical( "spherical" );
 const Name spike_dependent_threshold( "spike_dependent_threshold" );
 const Name spike_multiplicities( "spike_multiplicities" );
@@ -525,6 +536,7 @@ const Name u_bar_minus( "u_bar_minus" );
 const Name u_bar_plus( "u_bar_plus" );
 const Name u_ref_squared( "u_ref_squared" );
 const Name upper_right( "upper_right" );
+const Name use_secondary_delta( "use_secondary_delta" );
 const Name use_wfr( "use_wfr" );
 
 const Name V_T( "V_T" );
@@ -559,6 +571,7 @@ const Name weight_recorder( "weight_recorder" );
 const Name weighted_spikes_ex( "weighted_spikes_ex" );
 const Name weighted_spikes_in( "weighted_spikes_in" );
 const Name weights( "weights" );
+const Name wfr_adaptive( "wfr_adaptive" );
 const Name wfr_comm_interval( "wfr_comm_interval" );
 const Name wfr_interpolation_order( "wfr_interpolation_order" );
 const Name wfr_max_iterations( "wfr_max_iterations" );
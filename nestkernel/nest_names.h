@@ -73,6 +73,7 @@ extern const Name adapting_threshold;
 extern const Name adaptive_spike_buffers;
 extern const Name adaptive_target_buffers;
 extern const Name after_spike_currents;
+extern const Name aggregation;
 extern const Name ahp_bug;
 extern const Name allow_autapses;
 extern const Name allow_multapses;
@@ -96,6 +97,7 @@ extern const Name azimuth_angle;
 extern const Name b;
 extern const Name beta;
 extern const Name beta_Ca;
+extern const Name bin_width;
 extern const Name box;
 extern const Name buffer_size;
 extern const Name buffer_size_secondary_events;
@@ -112,6 +114,7 @@ extern const Name capacity;
 extern const Name center;
 extern const Name circular;
 extern const Name clear;
+extern const Name clear_events;
 extern const Name comparator;
 extern const Name configbit_0;
 extern const Name configbit_1;
@@ -121,6 +124,7 @@ extern const Name consistent_integration;
 extern const Name continuous;
 extern const Name count_covariance;
 extern const Name count_histogram;
+extern const Name counts;
 extern const Name covariance;
 
 extern const Name Delta_T;
@@ -302,6 +306,7 @@ extern const Name message_times;
 extern const Name messages;
 extern const Name min;
 extern const Name min_delay;
+extern const Name min_max;
 extern const Name minor_axis;
 extern const Name model;
 extern const Name mother_rng;
@@ -319,6 +324,7 @@ extern const Name N_channels;
 extern const Name n;
 extern const Name n_events;
 extern const Name n_messages;
+extern const Name n_neurons;
 extern const Name n_proc;
 extern const Name n_receptors;
 extern const Name n_synapses;
@@ -329,6 +335,7 @@ extern const Name no_synapses;
 extern const Name node_uses_wfr;
 extern const Name noise;
 extern const Name noisy_rate;
+extern const Name none;
 extern const Name num_connections;
 extern const Name num_processes;
 extern const Name number_of_connections;
@@ -350,6 +357,7 @@ extern const Name p_copy;
 extern const Name p_transmit;
 extern const Name pairwise_bernoulli_on_source;
 extern const Name pairwise_bernoulli_on_target;
+extern const Name per_neuron;
 extern const Name phase;
 extern const Name phi_max;
 extern const Name polar_angle;
@@ -409,6 +417,7 @@ extern const Name S;
 extern const Name S_act_NMDA;
 extern const Name scale;
 extern const Name sdev;
+extern const Name secondary_delta_tol;
 extern const Name senders;
 extern const Name shape;
 extern const Name shift_now_spikes;
@@ -423,6 +432,8 @@ extern const Name soma_exc;
 extern const Name soma_inh;
 extern const Name sort_connections_by_source;
 extern const Name source;
+extern const Name spatial_index;
+extern const Name spatial_position_cache_size;
 extern const Name spherical;
 extern const Name spike_dependent_threshold;
 extern const Name spike_multiplicities;
@@ -546,6 +557,7 @@ extern const Name u_bar_minus;
 extern const Name u_bar_plus;
 extern const Name u_ref_squared;
 extern const Name upper_right;
+extern const Name use_secondary_delta;
 extern const Name use_wfr;
 
 extern const Name V_T;
@@ -578,6 +590,7 @@ extern const Name weight_recorder;
 extern const Name weighted_spikes_ex;
 extern const Name weighted_spikes_in;
 extern const Name weights;
+extern const Name wfr_adaptive;
 extern const Name wfr_comm_interval;
 extern const Name wfr_interpolation_order;
 extern const Name wfr_max_iterations;
@@ -89,6 +89,7 @@ constexpr uint8_t NUM_BITS_SYN_ID = 6U;
 #endif
 constexpr uint8_t NUM_BITS_LCID = 27U;
 constexpr uint8_t NUM_BITS_PROCESSED_FLAG = 1U;
+constexpr uint8_t NUM_BITS_OFF_GRID_FLAG = 1U;
 constexpr uint8_t NUM_BITS_MARKER_SPIKE_DATA = 2U;
 constexpr uint8_t NUM_BITS_LAG = 14U;
 constexpr uint8_t NUM_BITS_DELAY = 21U;
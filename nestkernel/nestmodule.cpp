@@ -362,6 +362,53 @@ NestModule::SetStatus_CDFunction::execute( SLIInterpreter* i ) const
   i->EStack.pop();
 }
 
+/** @BeginDocumentation
+   Name: SetSpikeGeneratorTimes - set the spike times of many spike generators
+
+   Synopsis:
+   generators times offsets SetSpikeGeneratorTimes -> -
+
+   Description:
+   Sets the spike times of all spike generators in the NodeCollection
+   generators from the single array times. The spike times of the i-th
+   generator are the elements from times[offsets[i]] up to excluding
+   times[offsets[i + 1]], so that offsets has one element more than
+   generators. The times of each generator are converted only once and
+   shared between the instances of the generator on all threads.
+
+   SeeAlso: spike_generator, SetStatus
+*/
+void
+NestModule::SetSpikeGeneratorTimes_g_a_aFunction::execute( SLIInterpreter* i ) const
+{
+  i->assert_stack_load( 3 );
+
+  NodeCollectionDatum nc = getValue< NodeCollectionDatum >( i->OStack.pick( 2 ) );
+  std::vector< double > times = getValue< std::vector< double > >( i->OStack.pick( 1 ) );
+  std::vector< long > offsets = getValue< std::vector< long > >( i->OStack.pick( 0 ) );
+
+  if ( offsets.size() != nc->size() + 1 )
+  {
+    throw DimensionMismatch( nc->size() + 1, offsets.size() );
+  }
+  if ( offsets.back() > static_cast< long >( times.size() ) )
+  {
+    throw BadParameter( "Offsets must not point beyond the end of the spike times." );
+  }
+
+  std::vector< long > node_ids;
+  node_ids.reserve( nc->size() );
+  for ( NodeCollection::const_iterator it = nc->begin(); it < nc->end(); ++it )
+  {
+    node_ids.push_back( ( *it ).node_id );
+  }
+
+  set_spike_generator_times( node_ids.data(), node_ids.size(), times.data(), offsets.data() );
+
+  i->OStack.pop( 3 );
+  i->EStack.pop();
+}
+
 void
 NestModule::SetKernelStatus_DFunction::execute( SLIInterpreter* i ) const
 {
@@ -2845,6 +2892,7 @@ NestModule::init( SLIInterpreter* i )
   i->createcommand( "SetStatus_id", &setstatus_idfunction );
   i->createcommand( "SetStatus_CD", &setstatus_CDfunction );
   i->createcommand( "SetStatus_aa", &setstatus_aafunction );
+  i->createcommand( "SetSpikeGeneratorTimes_g_a_a", &setspikegeneratortimes_g_a_afunction );
   i->createcommand( "SetKernelStatus", &setkernelstatus_Dfunction );
 
   i->createcommand( "GetStatus_g", &getstatus_gfunction );
@@ -247,6 +247,12 @@ public:
     void execute( SLIInterpreter* ) const;
   } setstatus_CDfunction;
 
+  class SetSpikeGeneratorTimes_g_a_aFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const;
+  } setspikegeneratortimes_g_a_afunction;
+
   class SetKernelStatus_DFunction : public SLIFunction
   {
   public:
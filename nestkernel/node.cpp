@@ -226,6 +226,16 @@ Node::register_stdp_connection( double, double )
   throw IllegalConnection( "The target node does not support STDP synapses." );
 }
 
+/**
+ * Default implementation of share_spike_times() just
+ * throws BadProperty
+ */
+void
+Node::share_spike_times( const Node& )
+{
+  throw BadProperty( "The node does not have spike times." );
+}
+
 /**
  * Default implementation of event handlers just throws
  * an UnexpectedEvent exception.
@@ -475,6 +475,18 @@ public:
    */
   virtual void register_stdp_connection( double, double );
 
+  /**
+   * Take over the spike times of the instance of this node on another
+   * thread.
+   *
+   * Spike generators override this, so that set_spike_generator_times()
+   * converts the spike times of each generator only once and shares them
+   * between the instances on all threads.
+   *
+   * @throws BadProperty
+   */
+  virtual void share_spike_times( const Node& sibling );
+
   /**
    * Handle incoming spike events.
    * @param thrd Id of the calling thread.
@@ -28,7 +28,6 @@
 
 // C++ includes:
 #include <algorithm> // copy
-#include <numeric>   // accumulate
 
 
 namespace nest
@@ -487,6 +486,7 @@ NodeCollectionComposite::NodeCollectionComposite( const NodeCollectionPrimitive&
 {
   parts_.reserve( 1 );
   parts_.push_back( primitive );
+  set_part_offsets();
 }
 
 NodeCollectionComposite::NodeCollectionComposite( const NodeCollectionComposite& comp )
@@ -497,6 +497,7 @@ NodeCollectionComposite::NodeCollectionComposite( const NodeCollectionComposite&
   , start_offset_( comp.start_offset_ )
   , stop_part_( comp.stop_part_ )
   , stop_offset_( comp.stop_offset_ )
+  , part_offsets_( comp.part_offsets_ )
 {
 }
 
@@ -525,6 +526,7 @@ NodeCollectionComposite::NodeCollectionComposite( const std::vector< NodeCollect
     size_ += part.size();
   }
   std::sort( parts_.begin(), parts_.end(), primitiveSort );
+  set_part_offsets();
 }
 
 NodeCollectionComposite::NodeCollectionComposite( const NodeCollectionComposite& composite,
@@ -538,6 +540,7 @@ NodeCollectionComposite::NodeCollectionComposite( const NodeCollectionComposite&
   , start_offset_( 0 )
   , stop_part_( composite.parts_.size() )
   , stop_offset_( 0 )
+  , part_offsets_( composite.part_offsets_ )
 {
   if ( stop - start < 1 )
   {
@@ -564,23 +567,11 @@ NodeCollectionComposite::NodeCollectionComposite( const NodeCollectionComposite&
   }
   else
   {
-    // The NodeCollection is not sliced
-
-    // Iterate through the composite to find where to start and stop.
-    // TODO: There is some room for improvement here. Can go through parts instead, similar to in find().
-    size_t global_index = 0;
-    for ( const_iterator it = composite.begin(); it < composite.end(); ++it )
+    // The NodeCollection is not sliced, so indices into it are indices into the parts.
+    find_part_offset( start, start_part_, start_offset_ );
+    if ( stop < composite.size() )
     {
-      if ( global_index == start )
-      {
-        it.get_current_part_offset( start_part_, start_offset_ );
-      }
-      else if ( global_index == stop )
-      {
-        it.get_current_part_offset( stop_part_, stop_offset_ );
-        break;
-      }
-      ++global_index;
+      find_part_offset( stop, stop_part_, stop_offset_ );
     }
   }
 }
@@ -653,6 +644,7 @@ NodeCollectionPTR NodeCollectionComposite::operator+( NodeCollectionPTR rhs ) co
     }
     std::sort( new_composite->parts_.begin(), new_composite->parts_.end(), primitiveSort );
     merge_parts( new_composite->parts_ );
+    new_composite->set_part_offsets();
     if ( new_composite->parts_.size() == 1 )
     {
       // If there is only a single primitive in the composite, we extract it,
@@ -782,6 +774,17 @@ NodeCollectionComposite::slice( size_t start, size_t stop, size_t step ) const
   return NodeCollectionPTR( new NodeCollectionComposite( new_composite ) );
 }
 
+void
+NodeCollectionComposite::set_part_offsets()
+{
+  part_offsets_.resize( parts_.size() + 1 );
+  part_offsets_[ 0 ] = 0;
+  for ( size_t i = 0; i < parts_.size(); ++i )
+  {
+    part_offsets_[ i + 1 ] = part_offsets_[ i ] + parts_[ i ].size();
+  }
+}
+
 void
 NodeCollectionComposite::merge_parts( std::vector< NodeCollectionPrimitive >& parts ) const
 {
@@ -846,50 +849,35 @@ NodeCollectionComposite::contains( index node_id ) const
 long
 NodeCollectionComposite::find( const index node_id ) const
 {
-  if ( step_ > 1 or start_part_ > 0 or start_offset_ > 0 or ( stop_part_ > 0 and stop_part_ != parts_.size() )
-    or stop_offset_ > 0 )
+  // using the same algorithm as contains(), but returns the index if found.
+  long lower = 0;
+  long upper = parts_.size() - 1;
+  while ( lower <= upper )
   {
-    // Composite is sliced, we must iterate to find the index.
-    auto it = begin();
-    long index = 0;
-    for ( const_iterator it = begin(); it < end(); ++it, ++index )
+    long middle = std::floor( ( lower + upper ) / 2.0 );
+
+    if ( ( *( parts_[ middle ].begin() + ( parts_[ middle ].size() - 1 ) ) ).node_id < node_id )
     {
-      if ( ( *it ).node_id == node_id )
-      {
-        return index;
-      }
+      lower = middle + 1;
     }
-    return -1;
-  }
-  else
-  {
-    // using the same algorithm as contains(), but returns the node ID if found.
-    long lower = 0;
-    long upper = parts_.size() - 1;
-    while ( lower <= upper )
+    else if ( node_id < ( *( parts_[ middle ].begin() ) ).node_id )
     {
-      long middle = std::floor( ( lower + upper ) / 2.0 );
-
-      if ( ( *( parts_[ middle ].begin() + ( parts_[ middle ].size() - 1 ) ) ).node_id < node_id )
-      {
-        lower = middle + 1;
-      }
-      else if ( node_id < ( *( parts_[ middle ].begin() ) ).node_id )
-      {
-        upper = middle - 1;
-      }
-      else
+      upper = middle - 1;
+    }
+    else
+    {
+      // Index in the unsliced composite, mapped to the index in the slice.
+      const size_t unsliced_index = part_offsets_[ middle ] + parts_[ middle ].find( node_id );
+      const size_t start_index = part_offsets_[ start_part_ ] + start_offset_;
+      if ( unsliced_index < start_index or unsliced_index >= end_index()
+        or ( unsliced_index - start_index ) % step_ != 0 )
       {
-        auto size_accu = []( long a, const NodeCollectionPrimitive& b )
-        {
-          return a + b.size();
-        };
-        long sum_pre = std::accumulate( parts_.begin(), parts_.begin() + middle, ( long ) 0, size_accu );
-        return sum_pre + parts_[ middle ].find( node_id );
+        return -1;
       }
+      return ( unsliced_index - start_index ) / step_;
     }
-    return -1;
   }
+  return -1;
 }
 
 void
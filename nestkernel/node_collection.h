@@ -24,6 +24,7 @@
 #define NODE_COLLECTION_H
 
 // C++ includes:
+#include <algorithm>
 #include <ctime>
 #include <ostream>
 #include <stdexcept> // out_of_range
@@ -489,6 +490,12 @@ private:
   size_t stop_part_;                             //!< Primitive to stop at, set when slicing
   size_t stop_offset_;                           //!< Element to stop at, set when slicing
 
+  /**
+   * Index of the first element of each part in the unsliced composite,
+   * followed by the total number of elements in the parts.
+   */
+  std::vector< size_t > part_offsets_;
+
   /**
    * Goes through the vector of primitives, merging as much as possible.
    *
@@ -496,6 +503,28 @@ private:
    */
   void merge_parts( std::vector< NodeCollectionPrimitive >& parts ) const;
 
+  /**
+   * Computes part_offsets_ from the parts. Must be called whenever the
+   * parts change.
+   */
+  void set_part_offsets();
+
+  /**
+   * Finds the part and the offset within the part of an element, by
+   * binary search over the part offsets.
+   *
+   * @param index Index of the element in the unsliced composite.
+   * @param part Index of the part holding the element.
+   * @param offset Offset of the element within the part.
+   */
+  void find_part_offset( const size_t index, size_t& part, size_t& offset ) const;
+
+  /**
+   * @return index in the unsliced composite of the element after the last
+   * element of the composite.
+   */
+  size_t end_index() const;
+
 public:
   /**
    * Create a composite from a primitive, with boundaries and step length.
@@ -618,19 +647,9 @@ inline NodeIDTriple nc_const_iterator::operator*() const
 
     // Add to local placement from NodeCollectionPrimitives that comes before the
     // current one.
-    gt.lid = 0;
-    for ( const auto& part : composite_collection_->parts_ )
-    {
-      if ( part == composite_collection_->parts_[ part_idx_ ] )
-      {
-        break;
-      }
-      gt.lid += part.size();
-    }
-
+    gt.lid = composite_collection_->part_offsets_[ part_idx_ ] + element_idx_;
     gt.node_id = composite_collection_->parts_[ part_idx_ ][ element_idx_ ];
     gt.model_id = composite_collection_->parts_[ part_idx_ ].model_id_;
-    gt.lid += element_idx_;
   }
   return gt;
 }
@@ -688,9 +707,17 @@ inline nc_const_iterator& nc_const_iterator::operator+=( const size_t n )
   }
   else
   {
-    for ( size_t i = 0; i < n; ++i )
+    // Jump directly to the new position instead of stepping through the parts.
+    const size_t index = composite_collection_->part_offsets_[ part_idx_ ] + element_idx_ + n * step_;
+    if ( index >= composite_collection_->end_index() )
     {
-      operator++();
+      auto end_of_composite = composite_collection_->end();
+      part_idx_ = end_of_composite.part_idx_;
+      element_idx_ = end_of_composite.element_idx_;
+    }
+    else
+    {
+      composite_collection_->find_part_offset( index, part_idx_, element_idx_ );
     }
   }
   return *this;
@@ -821,21 +848,15 @@ inline index NodeCollectionComposite::operator[]( const size_t i ) const
   else
   {
     // Composite is unsliced, we can do a more efficient search.
-    size_t tot_prev_node_ids = 0;
-    for ( const auto& part : parts_ ) // iterate over NodeCollections
+    if ( i >= size_ )
     {
-      if ( tot_prev_node_ids + part.size() > i ) // is i in current NodeCollection?
-      {
-        size_t local_i = i - tot_prev_node_ids; // get local i
-        return part[ local_i ];
-      }
-      else // i is not in current NodeCollection
-      {
-        tot_prev_node_ids += part.size();
-      }
+      // throw exception if outside of NodeCollection
+      throw std::out_of_range( "pos points outside of the NodeCollection" );
     }
-    // throw exception if outside of NodeCollection
-    throw std::out_of_range( "pos points outside of the NodeCollection" );
+    size_t part;
+    size_t offset;
+    find_part_offset( i, part, offset );
+    return parts_[ part ][ offset ];
   }
 }
 
@@ -886,6 +907,24 @@ NodeCollectionComposite::size() const
   return size_;
 }
 
+inline void
+NodeCollectionComposite::find_part_offset( const size_t index, size_t& part, size_t& offset ) const
+{
+  // The last offset is the total size, so the part found is always valid for index < total size.
+  part = std::upper_bound( part_offsets_.begin(), part_offsets_.end(), index ) - part_offsets_.begin() - 1;
+  offset = index - part_offsets_[ part ];
+}
+
+inline size_t
+NodeCollectionComposite::end_index() const
+{
+  if ( stop_part_ != 0 or stop_offset_ != 0 )
+  {
+    return part_offsets_[ stop_part_ ] + stop_offset_;
+  }
+  return part_offsets_.back();
+}
+
 inline void
 NodeCollectionComposite::set_metadata( NodeCollectionMetadataPTR meta )
 {
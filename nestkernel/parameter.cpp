@@ -20,6 +20,9 @@
  *
  */
 
+// C++ includes:
+#include <algorithm>
+
 #include "node_collection.h"
 #include "node.h"
 #include "spatial.h"
@@ -39,6 +42,41 @@ Parameter::node_id_to_node_ptr_( const index node_id, const thread t ) const
   return kernel().node_manager.get_node_or_proxy( node_id, t );
 }
 
+size_t
+Parameter::num_positions_( const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer ) const
+{
+  const size_t num_dimensions = layer.get_num_dimensions();
+  const size_t num_positions = std::max( source_pos.size(), target_pos.size() ) / num_dimensions;
+  assert( source_pos.size() == num_dimensions or source_pos.size() == num_positions * num_dimensions );
+  assert( target_pos.size() == num_dimensions or target_pos.size() == num_positions * num_dimensions );
+  return num_positions;
+}
+
+void
+Parameter::values( librandom::RngPtr& rng,
+  const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer,
+  std::vector< double >& result ) const
+{
+  const size_t num_dimensions = layer.get_num_dimensions();
+  const size_t num_positions = num_positions_( source_pos, target_pos, layer );
+  const size_t source_stride = source_pos.size() == num_dimensions ? 0 : num_dimensions;
+  const size_t target_stride = target_pos.size() == num_dimensions ? 0 : num_dimensions;
+
+  std::vector< double > source( num_dimensions );
+  std::vector< double > target( num_dimensions );
+  result.resize( num_positions );
+  for ( size_t i = 0; i < num_positions; ++i )
+  {
+    std::copy_n( source_pos.begin() + i * source_stride, num_dimensions, source.begin() );
+    std::copy_n( target_pos.begin() + i * target_stride, num_dimensions, target.begin() );
+    result[ i ] = value( rng, source, target, layer );
+  }
+}
+
 std::vector< double >
 Parameter::apply( const NodeCollectionPTR& nc, const TokenArray& token_array ) const
 {
@@ -122,6 +160,30 @@ NodePosParameter::get_node_pos_( librandom::RngPtr& rng, Node* node ) const
   }
   return pos[ dimension_ ];
 }
+void
+NodePosParameter::values( librandom::RngPtr& rng,
+  const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer,
+  std::vector< double >& result ) const
+{
+  if ( synaptic_endpoint_ == 0 )
+  {
+    throw BadParameterValue( "Node position parameter cannot be used when connecting." );
+  }
+
+  const size_t num_dimensions = layer.get_num_dimensions();
+  const size_t num_positions = num_positions_( source_pos, target_pos, layer );
+  const std::vector< double >& pos = synaptic_endpoint_ == 1 ? source_pos : target_pos;
+  const size_t stride = pos.size() == num_dimensions ? 0 : num_dimensions;
+
+  result.resize( num_positions );
+  for ( size_t i = 0; i < num_positions; ++i )
+  {
+    result[ i ] = pos[ i * stride + dimension_ ];
+  }
+}
+
 double
 SpatialDistanceParameter::value( librandom::RngPtr& rng,
   const std::vector< double >& source_pos,
@@ -153,6 +215,34 @@ SpatialDistanceParameter::value( librandom::RngPtr& rng,
   }
 }
 
+void
+SpatialDistanceParameter::values( librandom::RngPtr& rng,
+  const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer,
+  std::vector< double >& result ) const
+{
+  if ( 3 < dimension_ or ( unsigned int ) dimension_ > layer.get_num_dimensions() )
+  {
+    // let value() report the error
+    Parameter::values( rng, source_pos, target_pos, layer, result );
+    return;
+  }
+
+  if ( dimension_ == 0 )
+  {
+    layer.compute_distances( source_pos, target_pos, result );
+  }
+  else
+  {
+    layer.compute_displacements( source_pos, target_pos, dimension_ - 1, result );
+    for ( double& displacement : result )
+    {
+      displacement = std::abs( displacement );
+    }
+  }
+}
+
 RedrawParameter::RedrawParameter( const Parameter& p, const double min, const double max )
   : Parameter( p )
   , p_( p.clone() )
@@ -161,6 +251,7 @@ RedrawParameter::RedrawParameter( const Parameter& p, const double min, const do
   , max_redraws_( 1000 )
 {
   parameter_is_spatial_ = p_->is_spatial();
+  parameter_is_random_ = p_->is_random();
   if ( min > max )
   {
     throw BadParameterValue( "min <= max required." );
@@ -223,4 +314,557 @@ RedrawParameter::value( librandom::RngPtr& rng,
   return value;
 }
 
+Parameter*
+Parameter::compile() const
+{
+  CompiledParameter* program = new CompiledParameter( *this );
+  program->set_result( compile_into( *program ) );
+  if ( program->is_trivial() )
+  {
+    delete program;
+    return nullptr;
+  }
+  return program;
+}
+
+size_t
+Parameter::compile_into( CompiledParameter& program ) const
+{
+  return program.call( *this );
+}
+
+size_t
+ConstantParameter::compile_into( CompiledParameter& program ) const
+{
+  return program.constant( value_ );
+}
+
+size_t
+NodePosParameter::compile_into( CompiledParameter& program ) const
+{
+  if ( synaptic_endpoint_ == 0 )
+  {
+    // let value() report the error
+    return Parameter::compile_into( program );
+  }
+  return program.position(
+    synaptic_endpoint_ == 1 ? CompiledParameter::SOURCE_POSITION : CompiledParameter::TARGET_POSITION, dimension_ );
+}
+
+size_t
+SpatialDistanceParameter::compile_into( CompiledParameter& program ) const
+{
+  if ( dimension_ == 0 )
+  {
+    return program.position( CompiledParameter::DISTANCE, 0 );
+  }
+  if ( dimension_ <= 3 )
+  {
+    return program.position( CompiledParameter::DISPLACEMENT, dimension_ - 1 );
+  }
+  // let value() report the error
+  return Parameter::compile_into( program );
+}
+
+size_t
+ProductParameter::compile_into( CompiledParameter& program ) const
+{
+  const size_t a = parameter1_->compile_into( program );
+  const size_t b = parameter2_->compile_into( program );
+  return program.operation( CompiledParameter::MULTIPLY, a, b );
+}
+
+size_t
+QuotientParameter::compile_into( CompiledParameter& program ) const
+{
+  const size_t a = parameter1_->compile_into( program );
+  const size_t b = parameter2_->compile_into( program );
+  return program.operation( CompiledParameter::DIVIDE, a, b );
+}
+
+size_t
+SumParameter::compile_into( CompiledParameter& program ) const
+{
+  const size_t a = parameter1_->compile_into( program );
+  const size_t b = parameter2_->compile_into( program );
+  return program.operation( CompiledParameter::ADD, a, b );
+}
+
+size_t
+DifferenceParameter::compile_into( CompiledParameter& program ) const
+{
+  const size_t a = parameter1_->compile_into( program );
+  const size_t b = parameter2_->compile_into( program );
+  return program.operation( CompiledParameter::SUBTRACT, a, b );
+}
+
+size_t
+ConverseParameter::compile_into( CompiledParameter& program ) const
+{
+  return p_->compile_into( program );
+}
+
+size_t
+ComparingParameter::compile_into( CompiledParameter& program ) const
+{
+  // same order as in compare_()
+  const CompiledParameter::Opcode comparators[] = { CompiledParameter::LESS,
+    CompiledParameter::LESS_EQUAL,
+    CompiledParameter::EQUAL,
+    CompiledParameter::NOT_EQUAL,
+    CompiledParameter::GREATER_EQUAL,
+    CompiledParameter::GREATER };
+
+  const size_t a = parameter1_->compile_into( program );
+  const size_t b = parameter2_->compile_into( program );
+  return program.operation( comparators[ comparator_ ], a, b );
+}
+
+size_t
+ConditionalParameter::compile_into( CompiledParameter& program ) const
+{
+  const CompiledParameter::Mark start = program.mark();
+  const size_t condition = condition_->compile_into( program );
+  if ( program.is_constant( condition ) )
+  {
+    // only the chosen branch is compiled
+    return program.constant_value( condition ) ? if_true_->compile_into( program )
+                                               : if_false_->compile_into( program );
+  }
+
+  // The select evaluates both branches, while value() only evaluates the
+  // chosen one. This is only equivalent if the branches consist of
+  // arithmetic on constants and positions. Any called parameter could draw
+  // random numbers or throw, so then the conditional is called as a whole.
+  const size_t num_calls = program.num_calls();
+  const size_t if_true = if_true_->compile_into( program );
+  const size_t if_false = if_false_->compile_into( program );
+  if ( program.num_calls() > num_calls )
+  {
+    program.rewind( start );
+    return Parameter::compile_into( program );
+  }
+  return program.operation( CompiledParameter::SELECT, condition, if_true, if_false );
+}
+
+size_t
+MinParameter::compile_into( CompiledParameter& program ) const
+{
+  const size_t a = p_->compile_into( program );
+  return program.operation( CompiledParameter::MIN, a, program.constant( other_value_ ) );
+}
+
+size_t
+MaxParameter::compile_into( CompiledParameter& program ) const
+{
+  const size_t a = p_->compile_into( program );
+  return program.operation( CompiledParameter::MAX, a, program.constant( other_value_ ) );
+}
+
+size_t
+ExpParameter::compile_into( CompiledParameter& program ) const
+{
+  return program.operation( CompiledParameter::EXP, p_->compile_into( program ) );
+}
+
+size_t
+SinParameter::compile_into( CompiledParameter& program ) const
+{
+  return program.operation( CompiledParameter::SIN, p_->compile_into( program ) );
+}
+
+size_t
+CosParameter::compile_into( CompiledParameter& program ) const
+{
+  return program.operation( CompiledParameter::COS, p_->compile_into( program ) );
+}
+
+size_t
+PowParameter::compile_into( CompiledParameter& program ) const
+{
+  const size_t a = p_->compile_into( program );
+  return program.operation( CompiledParameter::POW, a, program.constant( exponent_ ) );
+}
+
+namespace
+{
+
+inline double
+apply_operation( const CompiledParameter::Opcode op, const double a, const double b, const double c )
+{
+  switch ( op )
+  {
+  case CompiledParameter::ADD:
+    return a + b;
+  case CompiledParameter::SUBTRACT:
+    return a - b;
+  case CompiledParameter::MULTIPLY:
+    return a * b;
+  case CompiledParameter::DIVIDE:
+    return a / b;
+  case CompiledParameter::LESS:
+    return a < b;
+  case CompiledParameter::LESS_EQUAL:
+    return a <= b;
+  case CompiledParameter::EQUAL:
+    return a == b;
+  case CompiledParameter::NOT_EQUAL:
+    return a != b;
+  case CompiledParameter::GREATER_EQUAL:
+    return a >= b;
+  case CompiledParameter::GREATER:
+    return a > b;
+  case CompiledParameter::SELECT:
+    return a ? b : c;
+  case CompiledParameter::MIN:
+    return std::min( a, b );
+  case CompiledParameter::MAX:
+    return std::max( a, b );
+  case CompiledParameter::POW:
+    return std::pow( a, b );
+  case CompiledParameter::EXP:
+    return std::exp( a );
+  case CompiledParameter::SIN:
+    return std::sin( a );
+  case CompiledParameter::COS:
+    return std::cos( a );
+  default:
+    throw KernelException( "Invalid operation in compiled parameter." );
+  }
+}
+
+/**
+ * Apply an operation to a batch of operands. Constant operands have stride 0.
+ */
+template < CompiledParameter::Opcode op >
+void
+apply_operation_to_batch( double* result,
+  const size_t n,
+  const double* a,
+  const size_t a_stride,
+  const double* b,
+  const size_t b_stride,
+  const double* c,
+  const size_t c_stride )
+{
+  for ( size_t i = 0; i < n; ++i )
+  {
+    result[ i ] = apply_operation( op, a[ i * a_stride ], b[ i * b_stride ], c[ i * c_stride ] );
+  }
+}
+
+} // namespace
+
+CompiledParameter::CompiledParameter( const Parameter& p )
+  : Parameter( p )
+  , source_( p.clone() )
+  , result_( 0 )
+  , max_dimension_( -1 )
+{
+}
+
+size_t
+CompiledParameter::constant( const double value )
+{
+  registers_.push_back( value );
+  is_constant_.push_back( true );
+  return registers_.size() - 1;
+}
+
+size_t
+CompiledParameter::call( const Parameter& p )
+{
+  calls_.emplace_back( p.clone() );
+  registers_.push_back( 0.0 );
+  is_constant_.push_back( false );
+  program_.push_back( { CALL, registers_.size() - 1, 0, 0, 0, calls_.size() - 1 } );
+  return registers_.size() - 1;
+}
+
+size_t
+CompiledParameter::position( const Opcode op, const long dimension )
+{
+  assert( op == SOURCE_POSITION or op == TARGET_POSITION or op == DISTANCE or op == DISPLACEMENT );
+  if ( op != DISTANCE )
+  {
+    max_dimension_ = std::max( max_dimension_, dimension );
+  }
+  registers_.push_back( 0.0 );
+  is_constant_.push_back( false );
+  program_.push_back( { op, registers_.size() - 1, 0, 0, 0, static_cast< size_t >( dimension ) } );
+  return registers_.size() - 1;
+}
+
+size_t
+CompiledParameter::operation( const Opcode op, const size_t a, const size_t b, const size_t c )
+{
+  assert( ADD <= op );
+  if ( op == SELECT and is_constant_[ a ] )
+  {
+    return registers_[ a ] ? b : c;
+  }
+
+  const bool unary = EXP <= op;
+  if ( op != SELECT and is_constant_[ a ] and ( unary or is_constant_[ b ] ) )
+  {
+    return constant( apply_operation( op, registers_[ a ], registers_[ b ], registers_[ c ] ) );
+  }
+
+  registers_.push_back( 0.0 );
+  is_constant_.push_back( false );
+  program_.push_back( { op, registers_.size() - 1, a, b, c, 0 } );
+  return registers_.size() - 1;
+}
+
+CompiledParameter::Mark
+CompiledParameter::mark() const
+{
+  return { program_.size(), registers_.size(), calls_.size(), max_dimension_ };
+}
+
+void
+CompiledParameter::rewind( const Mark& mark )
+{
+  program_.resize( mark.num_instructions );
+  registers_.resize( mark.num_registers );
+  is_constant_.resize( mark.num_registers );
+  calls_.resize( mark.num_calls );
+  max_dimension_ = mark.max_dimension;
+}
+
+size_t
+CompiledParameter::num_calls() const
+{
+  return calls_.size();
+}
+
+bool
+CompiledParameter::is_trivial() const
+{
+  // a single register means that nothing was folded and at most one parameter is evaluated
+  return registers_.size() == 1;
+}
+
+bool
+CompiledParameter::supports_layer_( const AbstractLayer& layer ) const
+{
+  return max_dimension_ < static_cast< long >( layer.get_num_dimensions() );
+}
+
+double
+CompiledParameter::run_( librandom::RngPtr& rng,
+  const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer ) const
+{
+  if ( program_.empty() )
+  {
+    return registers_[ result_ ];
+  }
+
+  // registers are kept on the stack unless the program is very large
+  const size_t max_stack_registers = 32;
+  double stack_registers[ max_stack_registers ];
+  std::vector< double > heap_registers;
+  double* registers = stack_registers;
+  if ( registers_.size() > max_stack_registers )
+  {
+    heap_registers.resize( registers_.size() );
+    registers = heap_registers.data();
+  }
+  std::copy( registers_.begin(), registers_.end(), registers );
+
+  for ( const Instruction& instruction : program_ )
+  {
+    double& result = registers[ instruction.result ];
+    switch ( instruction.op )
+    {
+    case CALL:
+      result = calls_[ instruction.index ]->value( rng, source_pos, target_pos, layer );
+      break;
+    case SOURCE_POSITION:
+      result = source_pos[ instruction.index ];
+      break;
+    case TARGET_POSITION:
+      result = target_pos[ instruction.index ];
+      break;
+    case DISTANCE:
+      result = layer.compute_distance( source_pos, target_pos );
+      break;
+    case DISPLACEMENT:
+      result = std::abs( layer.compute_displacement( source_pos, target_pos, instruction.index ) );
+      break;
+    default:
+      result = apply_operation(
+        instruction.op, registers[ instruction.a ], registers[ instruction.b ], registers[ instruction.c ] );
+      break;
+    }
+  }
+  return registers[ result_ ];
+}
+
+double
+CompiledParameter::value( librandom::RngPtr& rng, Node* node ) const
+{
+  // without positions, a spatial leaf must only throw if its branch is chosen
+  return source_->value( rng, node );
+}
+
+double
+CompiledParameter::value( librandom::RngPtr& rng, index snode_id, Node* target, thread target_thread ) const
+{
+  return source_->value( rng, snode_id, target, target_thread );
+}
+
+double
+CompiledParameter::value( librandom::RngPtr& rng,
+  const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer ) const
+{
+  if ( not supports_layer_( layer ) )
+  {
+    return source_->value( rng, source_pos, target_pos, layer );
+  }
+  return run_( rng, source_pos, target_pos, layer );
+}
+
+void
+CompiledParameter::values( librandom::RngPtr& rng,
+  const std::vector< double >& source_pos,
+  const std::vector< double >& target_pos,
+  const AbstractLayer& layer,
+  std::vector< double >& result ) const
+{
+  if ( not supports_layer_( layer ) )
+  {
+    source_->values( rng, source_pos, target_pos, layer, result );
+    return;
+  }
+
+  const size_t num_dimensions = layer.get_num_dimensions();
+  const size_t num_positions = num_positions_( source_pos, target_pos, layer );
+  const size_t source_stride = source_pos.size() == num_dimensions ? 0 : num_dimensions;
+  const size_t target_stride = target_pos.size() == num_dimensions ? 0 : num_dimensions;
+
+  result.resize( num_positions );
+  if ( num_positions == 0 )
+  {
+    return;
+  }
+
+  // Each instruction writes an array over the batch, constants are read with stride 0.
+  std::vector< double > batch( program_.size() * num_positions );
+  std::vector< const double* > data( registers_.size() );
+  std::vector< size_t > stride( registers_.size(), 0 );
+  for ( size_t reg = 0; reg < registers_.size(); ++reg )
+  {
+    data[ reg ] = &registers_[ reg ];
+  }
+
+  std::vector< double > call_values;
+  for ( size_t k = 0; k < program_.size(); ++k )
+  {
+    const Instruction& instruction = program_[ k ];
+    double* out = &batch[ k * num_positions ];
+    const double* a = data[ instruction.a ];
+    const double* b = data[ instruction.b ];
+    const double* c = data[ instruction.c ];
+    const size_t sa = stride[ instruction.a ];
+    const size_t sb = stride[ instruction.b ];
+    const size_t sc = stride[ instruction.c ];
+
+    switch ( instruction.op )
+    {
+    case CALL:
+      calls_[ instruction.index ]->values( rng, source_pos, target_pos, layer, call_values );
+      std::copy( call_values.begin(), call_values.end(), out );
+      break;
+    case SOURCE_POSITION:
+      for ( size_t i = 0; i < num_positions; ++i )
+      {
+        out[ i ] = source_pos[ i * source_stride + instruction.index ];
+      }
+      break;
+    case TARGET_POSITION:
+      for ( size_t i = 0; i < num_positions; ++i )
+      {
+        out[ i ] = target_pos[ i * target_stride + instruction.index ];
+      }
+      break;
+    case DISTANCE:
+      layer.compute_distances( source_pos, target_pos, call_values );
+      std::copy( call_values.begin(), call_values.end(), out );
+      break;
+    case DISPLACEMENT:
+      layer.compute_displacements( source_pos, target_pos, instruction.index, call_values );
+      for ( size_t i = 0; i < num_positions; ++i )
+      {
+        out[ i ] = std::abs( call_values[ i ] );
+      }
+      break;
+    case ADD:
+      apply_operation_to_batch< ADD >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case SUBTRACT:
+      apply_operation_to_batch< SUBTRACT >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case MULTIPLY:
+      apply_operation_to_batch< MULTIPLY >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case DIVIDE:
+      apply_operation_to_batch< DIVIDE >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case LESS:
+      apply_operation_to_batch< LESS >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case LESS_EQUAL:
+      apply_operation_to_batch< LESS_EQUAL >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case EQUAL:
+      apply_operation_to_batch< EQUAL >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case NOT_EQUAL:
+      apply_operation_to_batch< NOT_EQUAL >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case GREATER_EQUAL:
+      apply_operation_to_batch< GREATER_EQUAL >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case GREATER:
+      apply_operation_to_batch< GREATER >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case SELECT:
+      apply_operation_to_batch< SELECT >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case MIN:
+      apply_operation_to_batch< MIN >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case MAX:
+      apply_operation_to_batch< MAX >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case POW:
+      apply_operation_to_batch< POW >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case EXP:
+      apply_operation_to_batch< EXP >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case SIN:
+      apply_operation_to_batch< SIN >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    case COS:
+      apply_operation_to_batch< COS >( out, num_positions, a, sa, b, sb, c, sc );
+      break;
+    }
+    data[ instruction.result ] = out;
+    stride[ instruction.result ] = 1;
+  }
+
+  const double* values = data[ result_ ];
+  const size_t values_stride = stride[ result_ ];
+  for ( size_t i = 0; i < num_positions; ++i )
+  {
+    result[ i ] = values[ i * values_stride ];
+  }
+}
+
 } /* namespace nest */
@@ -26,6 +26,8 @@
 // C++ includes:
 #include <limits>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 // Includes from librandom:
 #include "normal_randomdev.h"
@@ -44,6 +46,7 @@ namespace nest
 {
 
 class AbstractLayer;
+class CompiledParameter;
 
 /**
  * Abstract base class for parameters.
@@ -90,12 +93,49 @@ public:
     return value( rng, nullptr );
   }
 
+  /**
+   * Generates values for a batch of connections in one call.
+   *
+   * Positions are given one after the other in source_pos and target_pos.
+   * One of them may hold a single position only, which is then combined
+   * with all positions in the other. Composite parameters evaluate their
+   * operands for the whole batch before combining them, so random
+   * parameters draw all values of an operand in a row. Callers that need
+   * the same sequence of random numbers as from value() should therefore
+   * only use this method if is_random() is false.
+   * @param result vector that is resized to the number of positions and
+   *        filled with the values of the parameter.
+   */
+  virtual void values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const;
+
   /**
    * Create a copy of the parameter.
    * @returns dynamically allocated copy of parameter object
    */
   virtual Parameter* clone() const = 0;
 
+  /**
+   * Compile the parameter into a flat program.
+   *
+   * Deterministic subexpressions are folded into constants, the remaining
+   * operations are evaluated in a single loop over a list of instructions
+   * instead of by virtual calls through the tree of parameters.
+   * @returns a new dynamically allocated parameter, or nullptr if compiling
+   *          does not simplify the parameter.
+   */
+  Parameter* compile() const;
+
+  /**
+   * Append the instructions evaluating this parameter to a program.
+   * Parameters without a dedicated implementation are called as a whole.
+   * @returns the register of the program holding the value of the parameter.
+   */
+  virtual size_t compile_into( CompiledParameter& program ) const;
+
   /**
    * Create the product of this parameter with another.
    * @returns a new dynamically allocated parameter.
@@ -184,9 +224,34 @@ public:
    */
   bool is_spatial() const;
 
+  /**
+   * Check if the Parameter draws random numbers.
+   * @returns true if the Parameter or any of its operands is random, false otherwise.
+   */
+  bool is_random() const;
+
+  /**
+   * Check if the Parameter depends on the positions of the nodes themselves,
+   * rather than only on the displacement between them.
+   * Parameters are assumed to use node positions unless they opt out.
+   * @returns true if the Parameter or any of its operands uses node positions, false otherwise.
+   */
+  bool uses_node_positions() const;
+
 protected:
   bool parameter_is_spatial_{ false };
 
+  //! Parameters are assumed to be random unless they opt out explicitly
+  bool parameter_is_random_{ true };
+  bool parameter_uses_node_positions_{ true };
+
+  /**
+   * Returns the number of positions in a batch passed to values().
+   */
+  size_t num_positions_( const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer ) const;
+
   Node* node_id_to_node_ptr_( const index, const thread ) const;
 };
 
@@ -202,6 +267,8 @@ public:
     : Parameter()
     , value_( value )
   {
+    parameter_is_random_ = false;
+    parameter_uses_node_positions_ = false;
   }
 
   /**
@@ -211,6 +278,8 @@ public:
   ConstantParameter( const DictionaryDatum& d )
     : Parameter( d )
   {
+    parameter_is_random_ = false;
+    parameter_uses_node_positions_ = false;
     value_ = getValue< double >( d, "value" );
   }
 
@@ -225,6 +294,18 @@ public:
     return value_;
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    result.assign( num_positions_( source_pos, target_pos, layer ), value_ );
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -254,6 +335,8 @@ public:
     , lower_( 0.0 )
     , range_( 1.0 )
   {
+    parameter_is_random_ = true;
+    parameter_uses_node_positions_ = false;
     updateValue< double >( d, names::min, lower_ );
     updateValue< double >( d, names::max, range_ );
     if ( lower_ >= range_ )
@@ -302,6 +385,8 @@ public:
     , std_( 1.0 )
     , rdev()
   {
+    parameter_is_random_ = true;
+    parameter_uses_node_positions_ = false;
     updateValue< double >( d, names::mean, mean_ );
     updateValue< double >( d, names::std, std_ );
     if ( std_ <= 0 )
@@ -349,6 +434,8 @@ public:
     , std_( 1.0 )
     , rdev()
   {
+    parameter_is_random_ = true;
+    parameter_uses_node_positions_ = false;
     updateValue< double >( d, names::mean, mean_ );
     updateValue< double >( d, names::std, std_ );
     if ( std_ <= 0 )
@@ -393,6 +480,8 @@ public:
     : Parameter( d )
     , beta_( 1.0 )
   {
+    parameter_is_random_ = true;
+    parameter_uses_node_positions_ = false;
     updateValue< double >( d, names::beta, beta_ );
   }
 
@@ -433,6 +522,8 @@ public:
     , synaptic_endpoint_( 0 )
   {
     parameter_is_spatial_ = true;
+    parameter_is_random_ = false;
+    parameter_uses_node_positions_ = true;
     bool dimension_specified = updateValue< long >( d, names::dimension, dimension_ );
     if ( not dimension_specified )
     {
@@ -485,6 +576,14 @@ public:
     throw KernelException( "Wrong synaptic_endpoint_." );
   }
 
+  void values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override;
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -510,6 +609,8 @@ public:
     , dimension_( 0 )
   {
     parameter_is_spatial_ = true;
+    parameter_is_random_ = false;
+    parameter_uses_node_positions_ = false;
     updateValue< long >( d, names::dimension, dimension_ );
     if ( dimension_ < 0 )
     {
@@ -534,6 +635,14 @@ public:
     const std::vector< double >& target_pos,
     const AbstractLayer& layer ) const override;
 
+  void values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override;
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -561,6 +670,8 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   /**
@@ -572,6 +683,8 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   ~ProductParameter() override
@@ -606,6 +719,24 @@ public:
       * parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    std::vector< double > values2;
+    parameter1_->values( rng, source_pos, target_pos, layer, result );
+    parameter2_->values( rng, source_pos, target_pos, layer, values2 );
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+      result[ i ] = result[ i ] * values2[ i ];
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -632,6 +763,8 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   /**
@@ -643,6 +776,8 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   ~QuotientParameter() override
@@ -677,6 +812,24 @@ public:
       / parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    std::vector< double > values2;
+    parameter1_->values( rng, source_pos, target_pos, layer, result );
+    parameter2_->values( rng, source_pos, target_pos, layer, values2 );
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+      result[ i ] = result[ i ] / values2[ i ];
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -703,6 +856,8 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   /**
@@ -714,6 +869,8 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   ~SumParameter() override
@@ -748,6 +905,24 @@ public:
       + parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    std::vector< double > values2;
+    parameter1_->values( rng, source_pos, target_pos, layer, result );
+    parameter2_->values( rng, source_pos, target_pos, layer, values2 );
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+      result[ i ] = result[ i ] + values2[ i ];
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -774,6 +949,8 @@ public:
     , parameter2_( m2.clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   /**
@@ -785,6 +962,8 @@ public:
     , parameter2_( p.parameter2_->clone() )
   {
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   ~DifferenceParameter() override
@@ -819,6 +998,24 @@ public:
       - parameter2_->value( rng, source_pos, target_pos, layer );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    std::vector< double > values2;
+    parameter1_->values( rng, source_pos, target_pos, layer, result );
+    parameter2_->values( rng, source_pos, target_pos, layer, values2 );
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+      result[ i ] = result[ i ] - values2[ i ];
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -844,6 +1041,8 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   /**
@@ -854,6 +1053,8 @@ public:
     , p_( p.p_->clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~ConverseParameter() override
@@ -885,6 +1086,18 @@ public:
     return p_->value( rng, source_pos, target_pos, layer );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    p_->values( rng, source_pos, target_pos, layer, result );
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -930,6 +1143,8 @@ public:
       throw BadParameter( "Comparator specification has to be in the range 0-5." );
     }
     parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   /**
@@ -941,6 +1156,9 @@ public:
     , parameter2_( p.parameter2_->clone() )
     , comparator_( p.comparator_ )
   {
+    parameter_is_spatial_ = parameter1_->is_spatial() or parameter2_->is_spatial();
+    parameter_is_random_ = parameter1_->is_random() or parameter2_->is_random();
+    parameter_uses_node_positions_ = parameter1_->uses_node_positions() or parameter2_->uses_node_positions();
   }
 
   ~ComparingParameter() override
@@ -975,6 +1193,24 @@ public:
       parameter2_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    std::vector< double > values2;
+    parameter1_->values( rng, source_pos, target_pos, layer, result );
+    parameter2_->values( rng, source_pos, target_pos, layer, values2 );
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+      result[ i ] = compare_( result[ i ], values2[ i ] );
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1027,6 +1263,8 @@ public:
     , if_false_( if_false.clone() )
   {
     parameter_is_spatial_ = condition_->is_spatial() or if_true_->is_spatial() or if_false_->is_spatial();
+    parameter_is_random_ = condition_->is_random() or if_true_->is_random() or if_false_->is_random();
+    parameter_uses_node_positions_ = condition_->uses_node_positions() or if_true_->uses_node_positions() or if_false_->uses_node_positions();
   }
 
   /**
@@ -1039,6 +1277,8 @@ public:
     , if_false_( p.if_false_->clone() )
   {
     parameter_is_spatial_ = condition_->is_spatial() or if_true_->is_spatial() or if_false_->is_spatial();
+    parameter_is_random_ = condition_->is_random() or if_true_->is_random() or if_false_->is_random();
+    parameter_uses_node_positions_ = condition_->uses_node_positions() or if_true_->uses_node_positions() or if_false_->uses_node_positions();
   }
 
   ~ConditionalParameter() override
@@ -1093,6 +1333,26 @@ public:
     }
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    std::vector< double > values_true;
+    std::vector< double > values_false;
+    condition_->values( rng, source_pos, target_pos, layer, result );
+    if_true_->values( rng, source_pos, target_pos, layer, values_true );
+    if_false_->values( rng, source_pos, target_pos, layer, values_false );
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+      result[ i ] = result[ i ] ? values_true[ i ] : values_false[ i ];
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1120,6 +1380,8 @@ public:
     , other_value_( other_value )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   /**
@@ -1131,6 +1393,8 @@ public:
     , other_value_( p.other_value_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~MinParameter() override
@@ -1162,6 +1426,22 @@ public:
     return std::min( p_->value( rng, source_pos, target_pos, layer ), other_value_ );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    p_->values( rng, source_pos, target_pos, layer, result );
+    for ( auto& v : result )
+    {
+      v = std::min( v, other_value_ );
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1190,6 +1470,8 @@ public:
     , other_value_( other_value )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   /**
@@ -1201,6 +1483,8 @@ public:
     , other_value_( p.other_value_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~MaxParameter() override
@@ -1232,6 +1516,22 @@ public:
     return std::max( p_->value( rng, source_pos, target_pos, layer ), other_value_ );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    p_->values( rng, source_pos, target_pos, layer, result );
+    for ( auto& v : result )
+    {
+      v = std::max( v, other_value_ );
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1267,6 +1567,8 @@ public:
     , max_redraws_( p.max_redraws_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~RedrawParameter() override
@@ -1313,6 +1615,8 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   /**
@@ -1322,6 +1626,9 @@ public:
     : Parameter( p )
     , p_( p.p_->clone() )
   {
+    parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~ExpParameter() override
@@ -1353,6 +1660,22 @@ public:
     return std::exp( p_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    p_->values( rng, source_pos, target_pos, layer, result );
+    for ( auto& v : result )
+    {
+      v = std::exp( v );
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1379,6 +1702,8 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   /**
@@ -1389,6 +1714,8 @@ public:
     , p_( p.p_->clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~SinParameter() override
@@ -1420,6 +1747,22 @@ public:
     return std::sin( p_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    p_->values( rng, source_pos, target_pos, layer, result );
+    for ( auto& v : result )
+    {
+      v = std::sin( v );
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1445,6 +1788,8 @@ public:
     , p_( p.clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   /**
@@ -1455,6 +1800,8 @@ public:
     , p_( p.p_->clone() )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~CosParameter() override
@@ -1486,6 +1833,22 @@ public:
     return std::cos( p_->value( rng, source_pos, target_pos, layer ) );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    p_->values( rng, source_pos, target_pos, layer, result );
+    for ( auto& v : result )
+    {
+      v = std::cos( v );
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1513,6 +1876,8 @@ public:
     , exponent_( exponent )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   /**
@@ -1524,6 +1889,8 @@ public:
     , exponent_( p.exponent_ )
   {
     parameter_is_spatial_ = p_->is_spatial();
+    parameter_is_random_ = p_->is_random();
+    parameter_uses_node_positions_ = p_->uses_node_positions();
   }
 
   ~PowParameter() override
@@ -1555,6 +1922,22 @@ public:
     return std::pow( p_->value( rng, source_pos, target_pos, layer ), exponent_ );
   }
 
+  void
+  values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override
+  {
+    p_->values( rng, source_pos, target_pos, layer, result );
+    for ( auto& v : result )
+    {
+      v = std::pow( v, exponent_ );
+    }
+  }
+
+  size_t compile_into( CompiledParameter& program ) const override;
+
   Parameter*
   clone() const override
   {
@@ -1673,6 +2056,151 @@ protected:
 };
 
 
+/**
+ * Parameter evaluating a flat program compiled from a tree of parameters.
+ *
+ * The program is a list of instructions, each writing one register from
+ * registers holding constants or results of earlier instructions, so it is
+ * evaluated in a single pass. Instructions whose operands are all constant
+ * are folded when they are added. Parameters that are not compiled, such as
+ * random parameters, are called as leaves of the program in the order of
+ * the original tree, so random numbers are drawn in the same sequence.
+ *
+ * A conditional whose condition is not constant is compiled into a select
+ * of both branches only if neither branch calls a parameter, so that the
+ * program never draws random numbers, throws or does expensive work in the
+ * branch value() would not evaluate. Otherwise the conditional is called as
+ * a whole. Without positions, or with positions or displacements in
+ * dimensions the layer does not have, the original tree is evaluated
+ * instead of the program.
+ */
+class CompiledParameter : public Parameter
+{
+public:
+  using Parameter::value;
+
+  enum Opcode
+  {
+    CALL,
+    SOURCE_POSITION,
+    TARGET_POSITION,
+    DISTANCE,
+    DISPLACEMENT,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    LESS,
+    LESS_EQUAL,
+    EQUAL,
+    NOT_EQUAL,
+    GREATER_EQUAL,
+    GREATER,
+    SELECT,
+    MIN,
+    MAX,
+    POW,
+    EXP,
+    SIN,
+    COS
+  };
+
+  /**
+   * Create an empty program for the given parameter.
+   */
+  explicit CompiledParameter( const Parameter& p );
+
+  ~CompiledParameter() override = default;
+
+  double value( librandom::RngPtr& rng, Node* node ) const override;
+  double value( librandom::RngPtr& rng, index snode_id, Node* target, thread target_thread ) const override;
+  double value( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer ) const override;
+
+  void values( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer,
+    std::vector< double >& result ) const override;
+
+  Parameter*
+  clone() const override
+  {
+    return new CompiledParameter( *this );
+  }
+
+  /**
+   * Functions used by Parameter::compile_into() to build the program.
+   * Each returns the register holding the result.
+   */
+  size_t constant( const double value );
+  size_t call( const Parameter& p );
+  size_t position( const Opcode op, const long dimension );
+  size_t operation( const Opcode op, const size_t a, const size_t b = 0, const size_t c = 0 );
+
+  bool is_constant( const size_t reg ) const;
+  double constant_value( const size_t reg ) const;
+  void set_result( const size_t reg );
+
+  /**
+   * Size of the program, used to drop the instructions added after it was
+   * taken.
+   */
+  struct Mark
+  {
+    size_t num_instructions;
+    size_t num_registers;
+    size_t num_calls;
+    long max_dimension;
+  };
+
+  Mark mark() const;
+  void rewind( const Mark& mark );
+
+  /**
+   * Number of parameters called by the program.
+   */
+  size_t num_calls() const;
+
+  /**
+   * Check if the program only wraps a single parameter without simplifying it.
+   */
+  bool is_trivial() const;
+
+private:
+  struct Instruction
+  {
+    Opcode op;
+    size_t result;
+    size_t a;
+    size_t b;
+    size_t c;
+    size_t index; //!< leaf called or dimension of position
+  };
+
+  double run_( librandom::RngPtr& rng,
+    const std::vector< double >& source_pos,
+    const std::vector< double >& target_pos,
+    const AbstractLayer& layer ) const;
+
+  /**
+   * Check if the program can be run for positions in the given layer.
+   */
+  bool supports_layer_( const AbstractLayer& layer ) const;
+
+  std::shared_ptr< const Parameter > source_; //!< tree the program was compiled from
+
+  std::vector< Instruction > program_;
+  std::vector< double > registers_; //!< initial register values, holding the constants
+  std::vector< bool > is_constant_;
+  std::vector< std::shared_ptr< const Parameter > > calls_;
+  size_t result_;
+  long max_dimension_; //!< largest dimension of positions or displacements used, -1 if none
+};
+
+
 inline Parameter*
 Parameter::multiply_parameter( const Parameter& other ) const
 {
@@ -1768,6 +2296,37 @@ Parameter::is_spatial() const
   return parameter_is_spatial_;
 }
 
+inline bool
+Parameter::is_random() const
+{
+  return parameter_is_random_;
+}
+
+inline bool
+Parameter::uses_node_positions() const
+{
+  return parameter_uses_node_positions_;
+}
+
+inline bool
+CompiledParameter::is_constant( const size_t reg ) const
+{
+  return is_constant_[ reg ];
+}
+
+inline double
+CompiledParameter::constant_value( const size_t reg ) const
+{
+  assert( is_constant_[ reg ] );
+  return registers_[ reg ];
+}
+
+inline void
+CompiledParameter::set_result( const size_t reg )
+{
+  result_ = reg;
+}
+
 } // namespace nest
 
 #endif
@@ -22,7 +22,24 @@
 
 #include "recording_backend.h"
 
+// Includes from nestkernel:
+#include "event.h"
+
 const std::vector< Name > nest::RecordingBackend::NO_DOUBLE_VALUE_NAMES;
 const std::vector< Name > nest::RecordingBackend::NO_LONG_VALUE_NAMES;
 const std::vector< double > nest::RecordingBackend::NO_DOUBLE_VALUES;
 const std::vector< long > nest::RecordingBackend::NO_LONG_VALUES;
+
+void
+nest::RecordingBackend::write_samples( const RecordingDevice& device,
+  DataLoggingReply& reply,
+  size_t begin,
+  size_t end )
+{
+  const DataLoggingReply::Container& info = reply.get_info();
+  for ( size_t j = begin; j < end; ++j )
+  {
+    reply.set_stamp( info[ j ].timestamp );
+    write( device, reply, info[ j ].data, NO_LONG_VALUES );
+  }
+}
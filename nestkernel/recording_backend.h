@@ -35,6 +35,7 @@ namespace nest
 
 class RecordingDevice;
 class Event;
+class DataLoggingReply;
 
 /**
  * Abstract base class for all NESTio recording backends
@@ -246,6 +247,24 @@ public:
     const std::vector< double >& double_values,
     const std::vector< long >& long_values ) = 0;
 
+  /**
+   * Write the entries [begin, end) of the data sampled by a
+   * DataLoggingReply to the backend specific channel.
+   *
+   * All entries stem from the same sender and carry only double values.
+   * The default implementation calls write() once per entry with the time
+   * stamp of the reply set to that of the entry. Backends can override
+   * this to store all entries at once.
+   *
+   * @param device the RecordingDevice, backend-specific channel to write to
+   * @param reply the reply holding the sampled data
+   * @param begin index of first entry to write
+   * @param end index one past the last entry to write
+   *
+   * @ingroup NESTio
+   */
+  virtual void write_samples( const RecordingDevice& device, DataLoggingReply& reply, size_t begin, size_t end );
+
   /**
    * Set the status of the recording backend using the key-value pairs
    * contained in the params dictionary.
@@ -0,0 +1,630 @@
+/*
+ *  recording_backend_binary.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// C++ includes:
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+// Includes from libnestutil:
+#include "compose.hpp"
+
+// Includes from nestkernel:
+#include "recording_device.h"
+#include "vp_manager_impl.h"
+
+// includes from sli:
+#include "dictutils.h"
+
+#include "recording_backend_binary.h"
+
+const unsigned int nest::RecordingBackendBinary::BINARY_REC_BACKEND_VERSION = 1;
+
+namespace
+{
+
+void
+write_string( std::ofstream& file, const std::string& s )
+{
+  const uint32_t size = s.size();
+  file.write( reinterpret_cast< const char* >( &size ), sizeof( uint32_t ) );
+  file.write( s.data(), size );
+}
+
+template < typename T >
+void
+write_column( std::ofstream& file, const std::vector< T >& column )
+{
+  file.write( reinterpret_cast< const char* >( column.data() ), column.size() * sizeof( T ) );
+}
+
+} // namespace
+
+nest::RecordingBackendBinary::RecordingBackendBinary()
+  : buffer_size_( 1024 )
+  , io_stop_( false )
+{
+}
+
+nest::RecordingBackendBinary::~RecordingBackendBinary() throw()
+{
+  stop_io_thread_();
+}
+
+void
+nest::RecordingBackendBinary::initialize()
+{
+  data_map tmp( kernel().vp_manager.get_num_threads() );
+  device_data_.swap( tmp );
+}
+
+void
+nest::RecordingBackendBinary::finalize()
+{
+  stop_io_thread_();
+}
+
+void
+nest::RecordingBackendBinary::enroll( const RecordingDevice& device, const DictionaryDatum& params )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    std::string vp_node_id_string = compute_vp_node_id_string_( device );
+    std::string modelname = device.get_name();
+    // DeviceData holds a file stream and is constructed in place
+    auto p = device_data_[ t ].emplace( std::piecewise_construct,
+      std::forward_as_tuple( node_id ),
+      std::forward_as_tuple( modelname, vp_node_id_string ) );
+    device_data = p.first;
+  }
+
+  device_data->second.set_status( params );
+}
+
+void
+nest::RecordingBackendBinary::disenroll( const RecordingDevice& device )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    // the I/O thread must not hold on to the device when it is erased
+    wait_for_io_();
+    device_data_[ t ].erase( device_data );
+  }
+}
+
+void
+nest::RecordingBackendBinary::set_value_names( const RecordingDevice& device,
+  const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  assert( device_data != device_data_[ t ].end() );
+  device_data->second.set_value_names( double_value_names, long_value_names );
+}
+
+void
+nest::RecordingBackendBinary::prepare()
+{
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_info : inner )
+    {
+      device_info.second.open_file();
+    }
+  }
+
+  start_io_thread_();
+}
+
+void
+nest::RecordingBackendBinary::cleanup()
+{
+  stop_io_thread_();
+
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.close_file();
+    }
+  }
+}
+
+void
+nest::RecordingBackendBinary::pre_run_hook()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendBinary::post_run_hook()
+{
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      if ( device_data.second.get_num_buffered_events() > 0 )
+      {
+        hand_over_( device_data.second );
+      }
+    }
+  }
+
+  wait_for_io_();
+
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.flush_file();
+      if ( not device_data.second.file_good() )
+      {
+        LOG( M_ERROR, "RecordingBackendBinary::post_run_hook()", "I/O error while writing recorded data." );
+        throw IOError();
+      }
+    }
+  }
+}
+
+void
+nest::RecordingBackendBinary::post_step_hook()
+{
+  const thread t = kernel().vp_manager.get_thread_id();
+
+  for ( auto& device_data : device_data_[ t ] )
+  {
+    if ( device_data.second.get_num_buffered_events() >= static_cast< size_t >( buffer_size_ ) )
+    {
+      hand_over_( device_data.second );
+    }
+  }
+}
+
+void
+nest::RecordingBackendBinary::write( const RecordingDevice& device,
+  const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values )
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    return;
+  }
+
+  device_data->second.write( event, double_values, long_values );
+}
+
+void
+nest::RecordingBackendBinary::hand_over_( DeviceData& device_data )
+{
+  if ( not io_thread_.joinable() )
+  {
+    // without I/O thread, e.g., before Prepare, data is written right away
+    device_data.swap_buffers();
+    device_data.write_inactive_buffer();
+    return;
+  }
+
+  std::unique_lock< std::mutex > lock( io_mutex_ );
+  io_cond_.wait( lock, [&device_data] { return not device_data.in_flight; } );
+  device_data.swap_buffers();
+  device_data.in_flight = true;
+  io_queue_.push_back( &device_data );
+  lock.unlock();
+  io_cond_.notify_all();
+}
+
+void
+nest::RecordingBackendBinary::wait_for_io_()
+{
+  std::unique_lock< std::mutex > lock( io_mutex_ );
+  io_cond_.wait( lock,
+    [this]
+    {
+      if ( not io_queue_.empty() )
+      {
+        return false;
+      }
+      for ( auto& inner : device_data_ )
+      {
+        for ( auto& device_data : inner )
+        {
+          if ( device_data.second.in_flight )
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    } );
+}
+
+void
+nest::RecordingBackendBinary::start_io_thread_()
+{
+  if ( io_thread_.joinable() )
+  {
+    return;
+  }
+
+  io_stop_ = false;
+  io_thread_ = std::thread( &RecordingBackendBinary::io_loop_, this );
+}
+
+void
+nest::RecordingBackendBinary::stop_io_thread_()
+{
+  if ( not io_thread_.joinable() )
+  {
+    return;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock( io_mutex_ );
+    io_stop_ = true;
+  }
+  io_cond_.notify_all();
+  io_thread_.join();
+}
+
+void
+nest::RecordingBackendBinary::io_loop_()
+{
+  std::unique_lock< std::mutex > lock( io_mutex_ );
+  while ( true )
+  {
+    io_cond_.wait( lock, [this] { return io_stop_ or not io_queue_.empty(); } );
+
+    // the queue is drained before the thread stops
+    if ( io_queue_.empty() )
+    {
+      return;
+    }
+
+    DeviceData* device_data = io_queue_.front();
+    io_queue_.pop_front();
+
+    lock.unlock();
+    device_data->write_inactive_buffer();
+    lock.lock();
+
+    device_data->in_flight = false;
+    io_cond_.notify_all();
+  }
+}
+
+const std::string
+nest::RecordingBackendBinary::compute_vp_node_id_string_( const RecordingDevice& device ) const
+{
+  const float num_vps = kernel().vp_manager.get_num_virtual_processes();
+  const float num_nodes = kernel().node_manager.size();
+  const int vp_digits = static_cast< int >( std::floor( std::log10( num_vps ) ) + 1 );
+  const int node_id_digits = static_cast< int >( std::floor( std::log10( num_nodes ) ) + 1 );
+
+  std::ostringstream vp_node_id_string;
+  vp_node_id_string << "-" << std::setfill( '0' ) << std::setw( node_id_digits ) << device.get_node_id() << "-"
+                    << std::setfill( '0' ) << std::setw( vp_digits ) << device.get_vp();
+
+  return vp_node_id_string.str();
+}
+
+void
+nest::RecordingBackendBinary::set_status( const DictionaryDatum& d )
+{
+  long buffer_size = buffer_size_;
+  if ( updateValue< long >( d, names::buffer_size, buffer_size ) )
+  {
+    if ( buffer_size < 1 )
+    {
+      throw BadProperty( "buffer_size must be positive." );
+    }
+    buffer_size_ = buffer_size;
+  }
+}
+
+void
+nest::RecordingBackendBinary::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::buffer_size ] = buffer_size_;
+}
+
+void
+nest::RecordingBackendBinary::check_device_status( const DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.set_status( params ); // throws if params contains invalid entries
+}
+
+void
+nest::RecordingBackendBinary::get_device_defaults( DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.get_status( params );
+}
+
+void
+nest::RecordingBackendBinary::get_device_status( const nest::RecordingDevice& device, DictionaryDatum& d ) const
+{
+  const thread t = device.get_thread();
+  const index node_id = device.get_node_id();
+
+  data_map::value_type::const_iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data->second.get_status( d );
+  }
+}
+
+/* ******************* Event buffer class Buffer ******************* */
+
+void
+nest::RecordingBackendBinary::Buffer::clear()
+{
+  senders.clear();
+  times_steps.clear();
+  times_offset.clear();
+  times_ms.clear();
+  for ( auto& column : double_values )
+  {
+    column.clear();
+  }
+  for ( auto& column : long_values )
+  {
+    column.clear();
+  }
+}
+
+size_t
+nest::RecordingBackendBinary::Buffer::size() const
+{
+  return senders.size();
+}
+
+/* ******************* Device meta data class DeviceData ******************* */
+
+nest::RecordingBackendBinary::DeviceData::DeviceData( std::string modelname, std::string vp_node_id_string )
+  : in_flight( false )
+  , time_in_steps_( false )
+  , modelname_( modelname )
+  , vp_node_id_string_( vp_node_id_string )
+  , file_extension_( "nbin" )
+  , label_( "" )
+  , active_( 0 )
+{
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::set_value_names( const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  double_value_names_ = double_value_names;
+  long_value_names_ = long_value_names;
+
+  for ( auto& buffer : buffers_ )
+  {
+    buffer.double_values.resize( double_value_names.size() );
+    buffer.long_values.resize( long_value_names.size() );
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::open_file()
+{
+  std::string filename = compute_filename_();
+
+  std::ifstream test( filename.c_str() );
+  if ( test.good() && not kernel().io_manager.overwrite_files() )
+  {
+    std::string msg = String::compose(
+      "The file '%1' already exists and overwriting files is disabled. To overwrite files, set "
+      "the kernel property overwrite_files to true. To change the name or location of the file, "
+      "change the kernel properties data_path or data_prefix, or the device property label.",
+      filename );
+    LOG( M_ERROR, "RecordingBackendBinary::prepare()", msg );
+    throw IOError();
+  }
+  test.close();
+
+  file_ = std::ofstream( filename.c_str(), std::ios::binary );
+
+  if ( not file_.good() )
+  {
+    std::string msg = String::compose( "I/O error while opening file '%1'.", filename );
+    LOG( M_ERROR, "RecordingBackendBinary::prepare()", msg );
+    throw IOError();
+  }
+
+  file_.write( "NESTBIN", 8 ); // including the terminating null character
+  const uint32_t version = BINARY_REC_BACKEND_VERSION;
+  file_.write( reinterpret_cast< const char* >( &version ), sizeof( uint32_t ) );
+  write_string( file_, NEST_VERSION_STRING );
+  const char time_in_steps = time_in_steps_ ? 1 : 0;
+  file_.write( &time_in_steps, 1 );
+
+  const uint32_t n_double = double_value_names_.size();
+  file_.write( reinterpret_cast< const char* >( &n_double ), sizeof( uint32_t ) );
+  for ( auto& val : double_value_names_ )
+  {
+    write_string( file_, val.toString() );
+  }
+  const uint32_t n_long = long_value_names_.size();
+  file_.write( reinterpret_cast< const char* >( &n_long ), sizeof( uint32_t ) );
+  for ( auto& val : long_value_names_ )
+  {
+    write_string( file_, val.toString() );
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::write( const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values )
+{
+  Buffer& buffer = buffers_[ active_ ];
+
+  buffer.senders.push_back( event.get_sender_node_id() );
+
+  if ( time_in_steps_ )
+  {
+    buffer.times_steps.push_back( event.get_stamp().get_steps() );
+    buffer.times_offset.push_back( event.get_offset() );
+  }
+  else
+  {
+    buffer.times_ms.push_back( event.get_stamp().get_ms() - event.get_offset() );
+  }
+
+  for ( size_t i = 0; i < double_values.size(); ++i )
+  {
+    buffer.double_values[ i ].push_back( double_values[ i ] );
+  }
+  for ( size_t i = 0; i < long_values.size(); ++i )
+  {
+    buffer.long_values[ i ].push_back( long_values[ i ] );
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::swap_buffers()
+{
+  active_ = 1 - active_;
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::write_inactive_buffer()
+{
+  Buffer& buffer = buffers_[ 1 - active_ ];
+
+  const uint64_t n = buffer.size();
+  if ( n > 0 and file_.is_open() )
+  {
+    file_.write( reinterpret_cast< const char* >( &n ), sizeof( uint64_t ) );
+    write_column( file_, buffer.senders );
+    if ( time_in_steps_ )
+    {
+      write_column( file_, buffer.times_steps );
+      write_column( file_, buffer.times_offset );
+    }
+    else
+    {
+      write_column( file_, buffer.times_ms );
+    }
+    for ( auto& column : buffer.double_values )
+    {
+      write_column( file_, column );
+    }
+    for ( auto& column : buffer.long_values )
+    {
+      write_column( file_, column );
+    }
+  }
+
+  // clearing keeps the capacity, so the buffer does not grow again
+  buffer.clear();
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::flush_file()
+{
+  file_.flush();
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::close_file()
+{
+  file_.close();
+}
+
+bool
+nest::RecordingBackendBinary::DeviceData::file_good() const
+{
+  return not file_.is_open() or file_.good();
+}
+
+size_t
+nest::RecordingBackendBinary::DeviceData::get_num_buffered_events() const
+{
+  return buffers_[ active_ ].size();
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::file_extension ] = file_extension_;
+  ( *d )[ names::time_in_steps ] = time_in_steps_;
+
+  std::string filename = compute_filename_();
+  initialize_property_array( d, names::filenames );
+  append_property( d, names::filenames, filename );
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::set_status( const DictionaryDatum& d )
+{
+  updateValue< std::string >( d, names::file_extension, file_extension_ );
+  updateValue< std::string >( d, names::label, label_ );
+
+  bool time_in_steps = false;
+  if ( updateValue< bool >( d, names::time_in_steps, time_in_steps ) )
+  {
+    if ( kernel().simulation_manager.has_been_simulated() )
+    {
+      throw BadProperty( "Property time_in_steps cannot be set after Simulate has been called." );
+    }
+
+    time_in_steps_ = time_in_steps;
+  }
+}
+
+std::string
+nest::RecordingBackendBinary::DeviceData::compute_filename_() const
+{
+  std::string data_path = kernel().io_manager.get_data_path();
+  if ( not data_path.empty() and not( data_path[ data_path.size() - 1 ] == '/' ) )
+  {
+    data_path += '/';
+  }
+
+  std::string label = label_;
+  if ( label.empty() )
+  {
+    label = modelname_;
+  }
+
+  std::string data_prefix = kernel().io_manager.get_data_prefix();
+
+  return data_path + data_prefix + label + vp_node_id_string_ + "." + file_extension_;
+}
@@ -0,0 +1,273 @@
+/*
+ *  recording_backend_binary.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECORDING_BACKEND_BINARY_H
+#define RECORDING_BACKEND_BINARY_H
+
+// C++ includes:
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "recording_backend.h"
+
+/* BeginUserDocs: recording backend
+
+.. _binary_backend:
+
+Write data to binary files
+##########################
+
+The `binary` recording backend writes collected data to files in a
+compact binary format. It is meant for simulations that record a lot
+of data, where formatting every event as text, as done by the
+:ref:`ASCII backend <ascii_backend>`, would take a considerable
+fraction of the total run time. In contrast to the :ref:`SIONlib
+backend <sionlib_backend>`, it does not depend on any external library.
+
+Recorded events are collected in memory in one pair of buffers per
+recording device and thread. Once the active buffer holds at least
+``buffer_size`` events at the end of a time slice, the two buffers are
+exchanged and the full one is handed over to a background I/O thread,
+which writes it to the file while the simulation continues to record
+into the other buffer. At the end of each call to ``Run``, all
+remaining data is written and the files are flushed, so it is
+available for immediate inspection.
+
+Files are named and created in the same way as for the :ref:`ASCII
+backend <ascii_backend>`, using the pattern
+
+::
+
+   data_path/data_prefix(label|model_name)-node_id-vp.file_extension
+
+and the life of a file likewise starts with the call to ``Prepare``
+and ends with the call to ``Cleanup``.
+
+The files can be read into NumPy arrays using the PyNEST function
+``nest.read_binary_recording()``.
+
+Data format
++++++++++++
+
+All numbers are stored in the native byte order of the machine
+running the simulation. Integers are signed and 64 bits wide, unless
+noted otherwise, and floating point numbers are stored in double
+precision.
+
+Each file starts with a header consisting of the eight characters
+``NESTBIN`` followed by a null character, the version of the recording
+backend as 32 bit unsigned integer, the NEST version, a single byte
+that is 1 if ``time_in_steps`` was set and 0 otherwise, and the names
+of the recorded floating point and integer values. Strings are stored
+as a 32 bit unsigned integer length followed by the characters, and
+lists of names as a 32 bit unsigned integer count followed by the
+strings.
+
+The header is followed by any number of blocks. Each block starts with
+the number ``n`` of events in the block, followed by the data of all
+events stored column by column: ``n`` sender node IDs, the times of the
+events, and ``n`` entries for each recorded floating point value and
+each recorded integer value in the order given in the header. The
+times are stored as ``n`` floating point numbers in ms, or as ``n``
+integer steps followed by ``n`` floating point offsets in ms if
+``time_in_steps`` is set.
+
+Parameter summary
++++++++++++++++++
+
+The following properties are set for each recording device:
+
+.. glossary::
+
+ file_extension
+   A string (default: *"nbin"*) that specifies the file name extension,
+   without leading dot.
+
+ filenames
+   A list of the filenames where data is recorded to. This list has one
+   entry per local thread and is a read-only property.
+
+ label
+   A string (default: *""*) that replaces the model name component in
+   the filename if it is set.
+
+ time_in_steps
+   A Boolean (default: *false*) specifying whether to write time in
+   steps, i.e., in integer multiples of the simulation resolution plus
+   a floating point number for the negative offset from the next grid
+   point in ms, or just the simulation time in ms. This property
+   cannot be set after Simulate has been called.
+
+The following property is set for the backend via
+``SetKernelStatus( { "recording_backends": { "binary": { ... } } } )``:
+
+.. glossary::
+
+ buffer_size
+   The number of events (default: *1024*) that a buffer has to hold
+   before it is handed over to the I/O thread. Larger values result in
+   fewer and larger write operations at the cost of memory.
+
+EndUserDocs */
+
+namespace nest
+{
+
+/**
+ * Binary specialization of the RecordingBackend interface.
+ *
+ * RecordingBackendBinary maintains one file and two event buffers for
+ * every recording device instance on every thread. Threads only ever
+ * append to the active buffer of their own devices. In
+ * post_step_hook(), each thread exchanges the buffers of its devices
+ * whose active buffer is full and queues the devices for the I/O
+ * thread, which writes the inactive buffer to the file. A device is
+ * never queued twice, i.e., a thread waits for the I/O thread to
+ * finish with the inactive buffer before the buffers are exchanged
+ * again.
+ */
+class RecordingBackendBinary : public RecordingBackend
+{
+public:
+  const static unsigned int BINARY_REC_BACKEND_VERSION;
+
+  RecordingBackendBinary();
+
+  ~RecordingBackendBinary() throw();
+
+  void initialize() override;
+
+  void finalize() override;
+
+  void enroll( const RecordingDevice& device, const DictionaryDatum& params ) override;
+
+  void disenroll( const RecordingDevice& device ) override;
+
+  void set_value_names( const RecordingDevice& device,
+    const std::vector< Name >& double_value_names,
+    const std::vector< Name >& long_value_names ) override;
+
+  void prepare() override;
+
+  void cleanup() override;
+
+  void pre_run_hook() override;
+
+  /**
+   * Write all buffered data and flush files after a single call to Run
+   */
+  void post_run_hook() override;
+
+  /**
+   * Hand full buffers of the calling thread over to the I/O thread
+   */
+  void post_step_hook() override;
+
+  void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
+
+  void set_status( const DictionaryDatum& ) override;
+  void get_status( DictionaryDatum& ) const override;
+
+  void check_device_status( const DictionaryDatum& ) const override;
+  void get_device_defaults( DictionaryDatum& ) const override;
+  void get_device_status( const RecordingDevice& device, DictionaryDatum& ) const override;
+
+private:
+  const std::string compute_vp_node_id_string_( const RecordingDevice& device ) const;
+
+  //! Column-wise storage for the events recorded by one device
+  struct Buffer
+  {
+    void clear();
+    size_t size() const;
+
+    std::vector< int64_t > senders;
+    std::vector< int64_t > times_steps;
+    std::vector< double > times_offset;
+    std::vector< double > times_ms;
+    std::vector< std::vector< double > > double_values;
+    std::vector< std::vector< int64_t > > long_values;
+  };
+
+  struct DeviceData
+  {
+    DeviceData() = delete;
+    DeviceData( std::string, std::string );
+    void set_value_names( const std::vector< Name >&, const std::vector< Name >& );
+    void open_file();
+    void write( const Event&, const std::vector< double >&, const std::vector< long >& );
+    void swap_buffers();
+    void write_inactive_buffer();
+    void flush_file();
+    void close_file();
+    bool file_good() const;
+    size_t get_num_buffered_events() const;
+    void get_status( DictionaryDatum& ) const;
+    void set_status( const DictionaryDatum& );
+
+    bool in_flight; //!< Inactive buffer is queued or being written; guarded by io_mutex_
+
+  private:
+    bool time_in_steps_;                     //!< Should time be recorded in steps (ms if false)
+    std::string modelname_;                  //!< File name up to but not including the "."
+    std::string vp_node_id_string_;          //!< The vp and node ID component of the filename
+    std::string file_extension_;             //!< File name extension without leading "."
+    std::string label_;                      //!< The label of the device.
+    std::ofstream file_;                     //!< File stream to use for the device
+    std::vector< Name > double_value_names_; //!< names for values of type double
+    std::vector< Name > long_value_names_;   //!< names for values of type long
+    Buffer buffers_[ 2 ];                    //!< Active and inactive event buffer
+    size_t active_;                          //!< Index of the buffer currently recorded to
+
+    std::string compute_filename_() const; //!< Compose and return the filename
+  };
+
+  //! Exchange the buffers of the device and queue it for the I/O thread
+  void hand_over_( DeviceData& );
+
+  //! Block until the I/O thread has written all queued buffers
+  void wait_for_io_();
+
+  void start_io_thread_();
+  void stop_io_thread_();
+
+  //! Main loop of the I/O thread
+  void io_loop_();
+
+  typedef std::vector< std::map< size_t, DeviceData > > data_map;
+  data_map device_data_;
+
+  long buffer_size_; //!< Number of events after which buffers are handed over
+
+  std::thread io_thread_;
+  std::mutex io_mutex_;
+  std::condition_variable io_cond_;
+  std::deque< DeviceData* > io_queue_; //!< Devices with a full inactive buffer
+  bool io_stop_;                       //!< Tell the I/O thread to finish; guarded by io_mutex_
+};
+
+} // namespace
+
+#endif // RECORDING_BACKEND_BINARY_H
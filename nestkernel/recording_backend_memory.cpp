@@ -20,6 +20,10 @@
  *
  */
 
+// C++ includes:
+#include <algorithm>
+#include <cassert>
+
 // Includes from nestkernel:
 #include "recording_device.h"
 #include "vp_manager_impl.h"
@@ -112,6 +116,18 @@ nest::RecordingBackendMemory::write( const RecordingDevice& device,
   device_data_[ t ][ node_id ].push_back( event, double_values, long_values );
 }
 
+void
+nest::RecordingBackendMemory::write_samples( const RecordingDevice& device,
+  DataLoggingReply& reply,
+  size_t begin,
+  size_t end )
+{
+  thread t = device.get_thread();
+  index node_id = device.get_node_id();
+
+  device_data_[ t ][ node_id ].push_back_samples( reply, begin, end );
+}
+
 void
 nest::RecordingBackendMemory::check_device_status( const DictionaryDatum& params ) const
 {
@@ -169,10 +185,112 @@ nest::RecordingBackendMemory::prepare()
   // nothing to do
 }
 
+/* ******************* Chunked column of recorded values ******************* */
+
+template < typename T >
+nest::RecordingBackendMemory::Column< T >::Column()
+  : chunks_()
+  , spare_chunks_()
+  , begin_( 0 )
+  , size_( 0 )
+{
+}
+
+template < typename T >
+void
+nest::RecordingBackendMemory::Column< T >::add_chunk_()
+{
+  if ( spare_chunks_.empty() )
+  {
+    chunks_.push_back( std::vector< T >() );
+    chunks_.back().reserve( chunk_size_ );
+  }
+  else
+  {
+    chunks_.push_back( std::move( spare_chunks_.back() ) );
+    spare_chunks_.pop_back();
+  }
+}
+
+template < typename T >
+void
+nest::RecordingBackendMemory::Column< T >::push_back( const T& value )
+{
+  if ( chunks_.empty() or chunks_.back().size() == chunk_size_ )
+  {
+    add_chunk_();
+  }
+  chunks_.back().push_back( value );
+  ++size_;
+}
+
+template < typename T >
+void
+nest::RecordingBackendMemory::Column< T >::insert( size_t n, const T& value )
+{
+  size_ += n;
+  while ( n > 0 )
+  {
+    if ( chunks_.empty() or chunks_.back().size() == chunk_size_ )
+    {
+      add_chunk_();
+    }
+    const size_t n_chunk = std::min( n, chunk_size_ - chunks_.back().size() );
+    chunks_.back().insert( chunks_.back().end(), n_chunk, value );
+    n -= n_chunk;
+  }
+}
+
+template < typename T >
+size_t
+nest::RecordingBackendMemory::Column< T >::size() const
+{
+  return size_;
+}
+
+template < typename T >
+void
+nest::RecordingBackendMemory::Column< T >::append_to( std::vector< T >& values ) const
+{
+  values.reserve( values.size() + size_ );
+  size_t begin = begin_;
+  for ( const auto& chunk : chunks_ )
+  {
+    values.insert( values.end(), chunk.begin() + begin, chunk.end() );
+    begin = 0;
+  }
+}
+
+template < typename T >
+void
+nest::RecordingBackendMemory::Column< T >::discard( size_t n )
+{
+  assert( n <= size_ );
+  begin_ += n;
+  size_ -= n;
+
+  // release all chunks that have been read completely
+  while ( not chunks_.empty() and begin_ >= chunks_.front().size() )
+  {
+    begin_ -= chunks_.front().size();
+    chunks_.front().clear();
+    spare_chunks_.push_back( std::move( chunks_.front() ) );
+    chunks_.pop_front();
+  }
+}
+
+template < typename T >
+void
+nest::RecordingBackendMemory::Column< T >::clear()
+{
+  discard( size_ );
+}
+
 /* ******************* Device meta data class DeviceInfo ******************* */
 
 nest::RecordingBackendMemory::DeviceData::DeviceData()
   : time_in_steps_( false )
+  , n_read_( 0 )
 {
 }
 
@@ -214,6 +332,45 @@ nest::RecordingBackendMemory::DeviceData::push_back( const Event& event,
   }
 }
 
+void
+nest::RecordingBackendMemory::DeviceData::push_back_samples( const DataLoggingReply& reply, size_t begin, size_t end )
+{
+  if ( begin == end )
+  {
+    return;
+  }
+
+  const DataLoggingReply::Container& info = reply.get_info();
+
+  senders_.insert( end - begin, reply.get_sender_node_id() );
+
+  if ( time_in_steps_ )
+  {
+    for ( size_t j = begin; j < end; ++j )
+    {
+      times_steps_.push_back( info[ j ].timestamp.get_steps() );
+    }
+    times_offset_.insert( end - begin, reply.get_offset() );
+  }
+  else
+  {
+    for ( size_t j = begin; j < end; ++j )
+    {
+      times_ms_.push_back( info[ j ].timestamp.get_ms() - reply.get_offset() );
+    }
+  }
+
+  // fill the recorded values column by column
+  for ( size_t i = 0; i < info[ begin ].data.size(); ++i )
+  {
+    Column< double >& column = double_values_[ i ];
+    for ( size_t j = begin; j < end; ++j )
+    {
+      column.push_back( info[ j ].data[ i ] );
+    }
+  }
+}
+
 void
 nest::RecordingBackendMemory::DeviceData::get_status( DictionaryDatum& d ) const
 {
@@ -229,34 +386,30 @@ nest::RecordingBackendMemory::DeviceData::get_status( DictionaryDatum& d ) const
     events = getValue< DictionaryDatum >( d, names::events );
   }
 
-  initialize_property_intvector( events, names::senders );
-  append_property( events, names::senders, senders_ );
+  append_column_( events, names::senders, senders_ );
 
   if ( time_in_steps_ )
   {
-    initialize_property_intvector( events, names::times );
-    append_property( events, names::times, times_steps_ );
-
-    initialize_property_doublevector( events, names::offsets );
-    append_property( events, names::offsets, times_offset_ );
+    append_column_( events, names::times, times_steps_ );
+    append_column_( events, names::offsets, times_offset_ );
   }
   else
   {
-    initialize_property_doublevector( events, names::times );
-    append_property( events, names::times, times_ms_ );
+    append_column_( events, names::times, times_ms_ );
   }
 
   for ( size_t i = 0; i < double_values_.size(); ++i )
   {
-    initialize_property_doublevector( events, double_value_names_[ i ] );
-    append_property( events, double_value_names_[ i ], double_values_[ i ] );
+    append_column_( events, double_value_names_[ i ], double_values_[ i ] );
   }
   for ( size_t i = 0; i < long_values_.size(); ++i )
   {
-    initialize_property_intvector( events, long_value_names_[ i ] );
-    append_property( events, long_value_names_[ i ], long_values_[ i ] );
+    append_column_( events, long_value_names_[ i ], long_values_[ i ] );
   }
 
+  // clear_events discards only what has been handed out here
+  n_read_ = senders_.size();
+
   ( *d )[ names::time_in_steps ] = time_in_steps_;
 }
 
@@ -275,10 +428,71 @@ nest::RecordingBackendMemory::DeviceData::set_status( const DictionaryDatum& d )
   }
 
   size_t n_events = 1;
-  if ( updateValue< long >( d, names::n_events, n_events ) and n_events == 0 )
+  const bool reset_events = updateValue< long >( d, names::n_events, n_events ) and n_events == 0;
+
+  // clear_events keeps n_events, which is maintained by the device
+  bool clear_events = false;
+  updateValue< bool >( d, names::clear_events, clear_events );
+
+  if ( reset_events )
   {
     clear();
   }
+  else if ( clear_events )
+  {
+    discard_read();
+  }
+}
+
+void
+nest::RecordingBackendMemory::DeviceData::append_column_( DictionaryDatum& events,
+  const Name& name,
+  const Column< long >& column )
+{
+  initialize_property_intvector( events, name );
+  Token t = events->lookup( name );
+  IntVectorDatum* values = dynamic_cast< IntVectorDatum* >( t.datum() );
+  assert( values != 0 );
+  column.append_to( **values );
+}
+
+void
+nest::RecordingBackendMemory::DeviceData::append_column_( DictionaryDatum& events,
+  const Name& name,
+  const Column< double >& column )
+{
+  initialize_property_doublevector( events, name );
+  Token t = events->lookup( name );
+  DoubleVectorDatum* values = dynamic_cast< DoubleVectorDatum* >( t.datum() );
+  assert( values != 0 );
+  column.append_to( **values );
+}
+
+void
+nest::RecordingBackendMemory::DeviceData::discard_read()
+{
+  senders_.discard( n_read_ );
+
+  if ( time_in_steps_ )
+  {
+    times_steps_.discard( n_read_ );
+    times_offset_.discard( n_read_ );
+  }
+  else
+  {
+    times_ms_.discard( n_read_ );
+  }
+
+  for ( size_t i = 0; i < double_values_.size(); ++i )
+  {
+    double_values_[ i ].discard( n_read_ );
+  }
+  for ( size_t i = 0; i < long_values_.size(); ++i )
+  {
+    long_values_[ i ].discard( n_read_ );
+  }
+
+  n_read_ = 0;
 }
 
 void
@@ -297,4 +511,6 @@ nest::RecordingBackendMemory::DeviceData::clear()
   {
     long_values_[ i ].clear();
   }
+
+  n_read_ = 0;
 }
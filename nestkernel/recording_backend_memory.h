@@ -23,6 +23,10 @@
 #ifndef RECORDING_BACKEND_MEMORY_H
 #define RECORDING_BACKEND_MEMORY_H
 
+// C++ includes:
+#include <deque>
+#include <vector>
+
 // Includes from nestkernel:
 #include "recording_backend.h"
 
@@ -61,6 +65,14 @@ be read out of the `n_events` entry in the status dictionary of the
 recording device. To delete data from memory, `n_events` can be set to
 0. Other values cannot be set.
 
+For long simulations, the data can also be read incrementally: setting
+`clear_events` to `true` after reading out ``events`` removes the data
+read so far, while `n_events` keeps counting all events. Events recorded
+after the last readout are kept, and the next readout only contains
+events that have not been read before. The backend stores the data in
+chunks and keeps the chunks it no longer needs, so the data recorded next
+does not need to allocate memory again.
+
 Parameter summary
 +++++++++++++++++
 
@@ -78,6 +90,12 @@ Parameter summary
    `n_events`. By setting `n_events` to 0, all events recorded so far
    will be discarded from memory.
 
+ clear_events
+   Setting this to *true* discards the events returned by the last
+   readout of ``events`` from memory without resetting `n_events`, so
+   that the next readout only contains events not read before. It is not
+   part of the status.
+
  time_in_steps
    A Boolean (default: *false*) specifying whether to store time in
    steps, i.e., in integer multiples of the simulation resolution
@@ -106,6 +124,11 @@ namespace nest
  * the basic data structure during the call to enroll(), when the
  * exact fields are known.
  *
+ * The data of each device is stored in one column per field. Columns
+ * consist of chunks of fixed capacity, so that recording never moves
+ * data recorded before, and data that has been read and cleared is
+ * released chunk by chunk. Since every thread writes only to the data
+ * of its own device instances, no locking is required.
  */
 class RecordingBackendMemory : public RecordingBackend
 {
@@ -130,6 +153,8 @@ public:
 
   void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
 
+  void write_samples( const RecordingDevice&, DataLoggingReply&, size_t, size_t ) override;
+
   void pre_run_hook() override;
 
   void post_run_hook() override;
@@ -145,25 +170,74 @@ public:
   void get_device_status( const RecordingDevice& device, DictionaryDatum& ) const override;
 
 private:
+  /**
+   * Column of recorded values of one type.
+   *
+   * Values are stored in chunks of fixed capacity, so that appending
+   * never moves values recorded before. Discarding values from the front
+   * releases whole chunks, which are kept for reuse by later appends.
+   */
+  template < typename T >
+  class Column
+  {
+  public:
+    Column();
+
+    void push_back( const T& value );
+
+    //! Append n copies of value
+    void insert( size_t n, const T& value );
+
+    //! Return the number of values in the column
+    size_t size() const;
+
+    //! Append all values in the column to the given vector
+    void append_to( std::vector< T >& values ) const;
+
+    //! Remove the first n values from the column
+    void discard( size_t n );
+
+    void clear();
+
+  private:
+    void add_chunk_();
+
+    static const size_t chunk_size_ = 1024;
+
+    std::deque< std::vector< T > > chunks_;        //!< chunks in recording order, all but the last are full
+    std::vector< std::vector< T > > spare_chunks_; //!< released chunks kept for reuse
+    size_t begin_;                                 //!< position of the first value in the first chunk
+    size_t size_;                                  //!< number of values in the column
+  };
+
   struct DeviceData
   {
     DeviceData();
     void set_value_names( const std::vector< Name >&, const std::vector< Name >& );
     void push_back( const Event&, const std::vector< double >&, const std::vector< long >& );
+    void push_back_samples( const DataLoggingReply&, size_t, size_t );
     void get_status( DictionaryDatum& ) const;
     void set_status( const DictionaryDatum& );
 
   private:
     void clear();
-    std::vector< long > senders_;                        //!< sender node IDs of the events
-    std::vector< double > times_ms_;                     //!< times of registered events in ms
-    std::vector< long > times_steps_;                    //!< times of registered events in steps
-    std::vector< double > times_offset_;                 //!< offsets of registered events if time_in_steps_
-    std::vector< Name > double_value_names_;             //!< names for values of type double
-    std::vector< Name > long_value_names_;               //!< names for values of type long
-    std::vector< std::vector< double > > double_values_; //!< recorded values of type double, one vector per value
-    std::vector< std::vector< long > > long_values_;     //!< recorded values of type long, one vector per value
-    bool time_in_steps_;                                 //!< Should time be recorded in steps (ms if false)
+    void discard_read();
+
+    static void append_column_( DictionaryDatum&, const Name&, const Column< long >& );
+    static void append_column_( DictionaryDatum&, const Name&, const Column< double >& );
+
+    Column< long > senders_;                       //!< sender node IDs of the events
+    Column< double > times_ms_;                    //!< times of registered events in ms
+    Column< long > times_steps_;                   //!< times of registered events in steps
+    Column< double > times_offset_;                //!< offsets of registered events if time_in_steps_
+    std::vector< Name > double_value_names_;       //!< names for values of type double
+    std::vector< Name > long_value_names_;         //!< names for values of type long
+    std::vector< Column< double > > double_values_; //!< recorded values of type double, one column per value
+    std::vector< Column< long > > long_values_;     //!< recorded values of type long, one column per value
+    bool time_in_steps_;                           //!< Should time be recorded in steps (ms if false)
+
+    //! Number of events returned by the last readout, discarded by clear_events
+    mutable size_t n_read_;
   };
 
   typedef std::vector< std::map< size_t, DeviceData > > device_data_map;
@@ -222,3 +222,10 @@ nest::RecordingDevice::write( const Event& event,
   kernel().io_manager.write( P_.record_to_, *this, event, double_values, long_values );
   S_.n_events_++;
 }
+
+void
+nest::RecordingDevice::write_samples( DataLoggingReply& reply, size_t begin, size_t end )
+{
+  kernel().io_manager.write_samples( P_.record_to_, *this, reply, begin, end );
+  S_.n_events_ += end - begin;
+}
@@ -101,6 +101,11 @@ public:
 
 protected:
   void write( const Event&, const std::vector< double >&, const std::vector< long >& );
+
+  /**
+   * Write the entries [begin, end) sampled by a DataLoggingReply at once.
+   */
+  void write_samples( DataLoggingReply&, size_t, size_t );
   void set_initialized_() override;
 
 private:
@@ -57,6 +57,7 @@ nest::SimulationManager::SimulationManager()
   , wfr_tol_( 0.0001 )
   , wfr_max_iterations_( 15 )
   , wfr_interpolation_order_( 3 )
+  , wfr_adaptive_( false )
 {
 }
 
@@ -366,6 +367,9 @@ nest::SimulationManager::set_status( const DictionaryDatum& d )
       wfr_interpolation_order_ = interp_order;
     }
   }
+
+  // freeze converged nodes with unchanged input during wfr iterations
+  updateValue< bool >( d, names::wfr_adaptive, wfr_adaptive_ );
 }
 
 void
@@ -388,6 +392,7 @@ nest::SimulationManager::get_status( DictionaryDatum& d )
   def< double >( d, names::wfr_tol, wfr_tol_ );
   def< long >( d, names::wfr_max_iterations, wfr_max_iterations_ );
   def< long >( d, names::wfr_interpolation_order, wfr_interpolation_order_ );
+  def< bool >( d, names::wfr_adaptive, wfr_adaptive_ );
 }
 
 void
@@ -708,6 +713,17 @@ nest::SimulationManager::update_connection_infrastructure( const thread tid )
   kernel().connection_manager.unset_have_connections_changed( tid );
 }
 
+void
+nest::SimulationManager::update_connection_infrastructure_incrementally( const thread tid )
+{
+#pragma omp single
+  {
+    kernel().connection_manager.sync_has_primary_connections();
+    kernel().connection_manager.add_targets_of_new_connections();
+  }
+  kernel().connection_manager.unset_have_connections_changed( tid );
+}
+
 bool
 nest::SimulationManager::wfr_update_( Node* n )
 {
@@ -717,11 +733,12 @@ nest::SimulationManager::wfr_update_( Node* n )
 void
 nest::SimulationManager::update_()
 {
-  // to store done values of the different threads
-  std::vector< bool > done;
-  bool done_all = true;
   delay old_to_step;
 
+  // each thread reports convergence of its own wfr nodes in its own
+  // slot, so no critical section is needed to collect the flags
+  wfr_is_done_.initialize( kernel().vp_manager.get_num_threads(), true );
+
   std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( kernel().vp_manager.get_num_threads() );
 // parallel section begins
 #pragma omp parallel
@@ -739,12 +756,13 @@ nest::SimulationManager::update_()
         and ( std::fmod( Time( Time::step( clock_.get_steps() + from_step_ ) ).get_ms(),
                 kernel().sp_manager.get_structural_plasticity_update_interval() ) == 0 ) )
       {
+        const double t_sp = Time( Time::step( clock_.get_steps() + from_step_ ) ).get_ms();
         for ( SparseNodeArray::const_iterator i = kernel().node_manager.get_local_nodes( tid ).begin();
               i != kernel().node_manager.get_local_nodes( tid ).end();
               ++i )
         {
           Node* node = i->get_node();
-          node->update_synaptic_elements( Time( Time::step( clock_.get_steps() + from_step_ ) ).get_ms() );
+          node->update_synaptic_elements( t_sp );
         }
 #pragma omp barrier
 #pragma omp single
@@ -761,10 +779,23 @@ nest::SimulationManager::update_()
         }
 
         // after structural plasticity has created and deleted
-        // connections, update the connection infrastructure; implies
-        // complete removal of presynaptic part and reconstruction
-        // from postsynaptic data
-        update_connection_infrastructure( tid );
+        // connections, update the connection infrastructure; as long as
+        // few connections are unsorted or disabled, only the targets of
+        // new connections are added, otherwise this implies complete
+        // removal of presynaptic part and reconstruction from
+        // postsynaptic data
+#pragma omp single
+        {
+          kernel().connection_manager.check_incremental_update_possible();
+        }
+        if ( kernel().connection_manager.incremental_update_possible() )
+        {
+          update_connection_infrastructure_incrementally( tid );
+        }
+        else
+        {
+          update_connection_infrastructure( tid );
+        }
 
       } // of structural plasticity
 
@@ -834,29 +865,23 @@ nest::SimulationManager::update_()
             done_p = wfr_update_( *i ) and done_p;
           }
 
-// add done value of thread p to done vector
-#pragma omp critical
-          done.push_back( done_p );
-// parallel section ends, wait until all threads are done -> synchronize
-#pragma omp barrier
+          wfr_is_done_[ tid ].set_false();
+          if ( done_p )
+          {
+            wfr_is_done_[ tid ].set_true();
+          }
+
+          // all_true() waits for all threads to finish their sweep and
+          // reduces the per-thread flags; every thread obtains the same
+          // result, so no shared variable has to be written
+          const bool done_all = wfr_is_done_.all_true();
 
 // the following block is executed by a single thread
 // the other threads wait at the end of the block
 #pragma omp single
           {
-            // check whether all threads are done
-            for ( size_t i = 0; i < done.size(); ++i )
-            {
-              done_all = done[ i ] and done_all;
-            }
-
             // gather SecondaryEvents (e.g. GapJunctionEvents)
             kernel().event_delivery_manager.gather_secondary_events( done_all );
-
-            // reset done and done_all
-            //(needs to be in the single threaded part)
-            done_all = true;
-            done.clear();
           }
 
           // deliver SecondaryEvents generated during wfr_update
@@ -946,12 +971,13 @@ nest::SimulationManager::update_()
     } while ( to_do_ > 0 and not exceptions_raised.at( tid ) );
 
     // End of the slice, we update the number of synaptic elements
+    const double t_slice_end = Time( Time::step( clock_.get_steps() + to_step_ ) ).get_ms();
     for ( SparseNodeArray::const_iterator i = kernel().node_manager.get_local_nodes( tid ).begin();
           i != kernel().node_manager.get_local_nodes( tid ).end();
           ++i )
     {
       Node* node = i->get_node();
-      node->update_synaptic_elements( Time( Time::step( clock_.get_steps() + to_step_ ) ).get_ms() );
+      node->update_synaptic_elements( t_slice_end );
     }
   } // of omp parallel
 
@@ -35,6 +35,7 @@
 // Includes from nestkernel:
 #include "nest_time.h"
 #include "nest_types.h"
+#include "per_thread_bool_indicator.h"
 
 // Includes from sli:
 #include "dictdatum.h"
@@ -104,6 +105,12 @@ public:
    */
   size_t get_wfr_interpolation_order() const;
 
+  /**
+   * Returns true if nodes whose input did not change may skip
+   * re-integration during waveform relaxation iterations
+   */
+  bool get_wfr_adaptive() const;
+
   /**
    * Get the time at the beginning of the current time slice.
    */
@@ -156,6 +163,10 @@ public:
   //! Sorts source table and connections and create new target table.
   void update_connection_infrastructure( const thread tid );
 
+  //! Adds the targets of connections created since the last update to
+  //! the target table, without sorting or restructuring.
+  void update_connection_infrastructure_incrementally( const thread tid );
+
 private:
   void call_update_(); //!< actually run simulation, aka wrap update_
   void update_();      //! actually perform simulation
@@ -189,6 +200,10 @@ private:
                                    //!< relaxation
   size_t wfr_interpolation_order_; //!< interpolation order for waveform
                                    //!< relaxation method
+  bool wfr_adaptive_;              //!< converged nodes with unchanged input
+                                   //!< are frozen during wfr iterations
+  PerThreadBoolIndicator wfr_is_done_; //!< per-thread convergence flags of the
+                                       //!< current waveform relaxation iteration
 };
 
 inline Time const&
@@ -263,6 +278,12 @@ SimulationManager::get_wfr_interpolation_order() const
 {
   return wfr_interpolation_order_;
 }
+
+inline bool
+SimulationManager::get_wfr_adaptive() const
+{
+  return wfr_adaptive_;
+}
 }
 
 
@@ -27,7 +27,8 @@
 #include <limits>
 
 nest::SliceRingBuffer::SliceRingBuffer()
-  : refract_( std::numeric_limits< long >::max(), 0, 0 )
+  : buckets_( 1 )
+  , refract_( std::numeric_limits< long >::max(), 0, 0 )
 {
   //  resize();  // sets up queue_
 }
@@ -35,12 +36,14 @@ nest::SliceRingBuffer::SliceRingBuffer()
 void
 nest::SliceRingBuffer::resize()
 {
-  long newsize = static_cast< long >( std::ceil(
-    static_cast< double >( kernel().connection_manager.get_min_delay() + kernel().connection_manager.get_max_delay() )
-    / kernel().connection_manager.get_min_delay() ) );
-  if ( queue_.size() != static_cast< unsigned long >( newsize ) )
+  const long min_delay = kernel().connection_manager.get_min_delay();
+  const long newsize = static_cast< long >( std::ceil(
+    static_cast< double >( min_delay + kernel().connection_manager.get_max_delay() ) / min_delay ) );
+  if ( queue_.size() != static_cast< unsigned long >( newsize )
+    or buckets_.size() != static_cast< unsigned long >( min_delay ) )
   {
     queue_.resize( newsize );
+    buckets_.resize( min_delay );
     clear();
   }
 
@@ -50,6 +53,10 @@ nest::SliceRingBuffer::resize()
   {
     queue_[ j ].reserve( 1 );
   }
+  for ( size_t j = 0; j < buckets_.size(); ++j )
+  {
+    buckets_[ j ].reserve( 1 );
+  }
 #endif
 }
 
@@ -60,23 +67,40 @@ nest::SliceRingBuffer::clear()
   {
     queue_[ j ].clear();
   }
+  for ( size_t j = 0; j < buckets_.size(); ++j )
+  {
+    buckets_[ j ].clear();
+  }
 }
 
 void
 nest::SliceRingBuffer::prepare_delivery()
 {
-  // vector to deliver from in this slice
-  deliver_ = &( queue_[ kernel().event_delivery_manager.get_slice_modulo( 0 ) ] );
+  // distribute events of this slice over the buckets of their time steps
+  std::vector< SpikeInfo >& slice = queue_[ kernel().event_delivery_manager.get_slice_modulo( 0 ) ];
+  for ( size_t j = 0; j < slice.size(); ++j )
+  {
+    get_bucket_( slice[ j ].stamp_ ).push_back( slice[ j ] );
+  }
+  slice.clear();
 
-  // sort events, first event last
-  std::sort( deliver_->begin(), deliver_->end(), std::greater< SpikeInfo >() );
+  // sort events in each bucket, first event last
+  for ( size_t lag = 0; lag < buckets_.size(); ++lag )
+  {
+    if ( buckets_[ lag ].size() > 1 )
+    {
+      std::sort( buckets_[ lag ].begin(), buckets_[ lag ].end(), std::greater< SpikeInfo >() );
+    }
+  }
 }
 
 void
 nest::SliceRingBuffer::discard_events()
 {
-  // vector to deliver from in this slice
-  deliver_ = &( queue_[ kernel().event_delivery_manager.get_slice_modulo( 0 ) ] );
+  queue_[ kernel().event_delivery_manager.get_slice_modulo( 0 ) ].clear();
 
-  deliver_->clear();
+  for ( size_t lag = 0; lag < buckets_.size(); ++lag )
+  {
+    buckets_[ lag ].clear();
+  }
 }
@@ -40,18 +40,25 @@ namespace nest
 {
 /**
  * Queue for all spikes arriving into a neuron.
- * Spikes are stored unsorted on arrival, but are sorted when
- * prepare_delivery() is called.  They can then be retrieved
- * one by one in correct temporal order.  Coinciding spikes
- * are combined into one, see get_next_spike().
+ * Spikes are stored on arrival in slices, unsorted. When
+ * prepare_delivery() is called, the spikes of the current slice are
+ * distributed over one bucket per time step and each bucket is sorted
+ * by offset.  Spikes can then be retrieved one by one in correct
+ * temporal order.  Coinciding spikes are combined into one, see
+ * get_next_spike().
  *
  * Data is organized as follows:
  * - The time of the next return from refractoriness is
  *   stored in a separate variable and checked explicitly;
  *   otherwise, we'd have to re-sort data during updating.
- * - We have a pseudo-ring of Nbuff=ceil((min_del+max_del)/min_del) elements.
- *   Each element is a vector storing incoming spikes that
- *   are due during a given time slice.
+ * - We have a pseudo-ring of Nbuff=ceil((min_del+max_del)/min_del) slices.
+ *   Each slice is a vector storing incoming spikes that are due during a
+ *   given slice.
+ * - There are min_del buckets, one per time step of the slice that is
+ *   being delivered. They are reused for every slice, so the buffer holds
+ *   Nbuff + min_del vectors, and they keep their capacity from slice to
+ *   slice. Since all spikes in a bucket share their time stamp, only
+ *   spikes arriving during the same step are sorted.
  *
  * @note The following assumptions underlie the handling of
  * pseudo-events for return from refractoriness:
@@ -141,11 +148,17 @@ private:
     double weight_;    //<! spike weight
   };
 
-  //! entire queue, one slot per min_delay block within max_delay
+  /**
+   * Return bucket holding spikes with given stamp in the slice being
+   * delivered.
+   */
+  std::vector< SpikeInfo >& get_bucket_( const long stamp );
+
+  //! entire queue, one slice of unsorted spikes per min_delay
   std::vector< std::vector< SpikeInfo > > queue_;
 
-  //! slot to deliver from
-  std::vector< SpikeInfo >* deliver_;
+  //! one bucket per time step of the slice being delivered
+  std::vector< std::vector< SpikeInfo > > buckets_;
 
   SpikeInfo refract_; //!< pseudo-event for return from refractoriness
 };
@@ -181,7 +194,8 @@ SliceRingBuffer::get_next_spike( const long req_stamp,
   bool& end_of_refract )
 {
   end_of_refract = false;
-  if ( deliver_->empty() || refract_ <= deliver_->back() )
+  std::vector< SpikeInfo >& deliver = get_bucket_( req_stamp );
+  if ( deliver.empty() || refract_ <= deliver.back() )
   {
     if ( refract_.stamp_ == req_stamp )
     { // if relies on stamp_==long::max() if not refractory
@@ -199,32 +213,37 @@ SliceRingBuffer::get_next_spike( const long req_stamp,
       return false;
     }
   }
-  else if ( deliver_->back().stamp_ == req_stamp )
+  else
   {
+    // buckets only hold spikes of a single stamp; ensure that we are not
+    // blocked by spike from the past, cf #404
+    assert( deliver.back().stamp_ == req_stamp );
+
     // we have an event to deliver
-    ps_offset = deliver_->back().ps_offset_;
-    weight = deliver_->back().weight_;
-    deliver_->pop_back();
+    ps_offset = deliver.back().ps_offset_;
+    weight = deliver.back().weight_;
+    deliver.pop_back();
 
     if ( accumulate_simultaneous )
     {
-      // add weights of all spikes with same stamp and offset
-      while (
-        not deliver_->empty() and deliver_->back().ps_offset_ == ps_offset and deliver_->back().stamp_ == req_stamp )
+      // add weights of all spikes with same offset
+      while ( not deliver.empty() and deliver.back().ps_offset_ == ps_offset )
       {
-        weight += deliver_->back().weight_;
-        deliver_->pop_back();
+        weight += deliver.back().weight_;
+        deliver.pop_back();
       }
     }
 
     return true;
   }
-  else
-  {
-    // ensure that we are not blocked by spike from the past, cf #404
-    assert( deliver_->back().stamp_ > req_stamp );
-    return false;
-  }
+}
+
+inline std::vector< SliceRingBuffer::SpikeInfo >&
+SliceRingBuffer::get_bucket_( const long stamp )
+{
+  // a slice covers min_delay consecutive stamps, which are thus mapped to
+  // distinct buckets
+  return buckets_[ stamp % buckets_.size() ];
 }
 
 inline SliceRingBuffer::SpikeInfo::SpikeInfo( long stamp, double ps_offset, double weight )
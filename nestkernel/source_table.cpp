@@ -49,11 +49,23 @@ nest::SourceTable::initialize()
   saved_entry_point_.initialize( num_threads, false );
   current_positions_.resize( num_threads );
   saved_positions_.resize( num_threads );
+  num_sorted_sources_.resize( num_threads );
+  num_communicated_sources_.resize( num_threads );
+  num_disabled_sources_.resize( num_threads, 0 );
+  unsorted_index_.resize( num_threads );
+  unsorted_index_begin_.resize( num_threads );
+  unsorted_index_end_.resize( num_threads );
 
 #pragma omp parallel
   {
     const thread tid = kernel().vp_manager.get_thread_id();
     sources_[ tid ].resize( 0 );
+    num_sorted_sources_[ tid ].resize( 0 );
+    num_communicated_sources_[ tid ].resize( 0 );
+    num_disabled_sources_[ tid ] = 0;
+    unsorted_index_[ tid ].resize( 0 );
+    unsorted_index_begin_[ tid ].resize( 0 );
+    unsorted_index_end_[ tid ].resize( 0 );
     resize_sources( tid );
   } // of omp parallel
 }
@@ -72,6 +84,12 @@ nest::SourceTable::finalize()
   sources_.clear();
   current_positions_.clear();
   saved_positions_.clear();
+  num_sorted_sources_.clear();
+  num_communicated_sources_.clear();
+  num_disabled_sources_.clear();
+  unsorted_index_.clear();
+  unsorted_index_begin_.clear();
+  unsorted_index_end_.clear();
 }
 
 bool
@@ -263,6 +281,51 @@ void
 nest::SourceTable::resize_sources( const thread tid )
 {
   sources_[ tid ].resize( kernel().model_manager.get_num_synapse_prototypes() );
+  num_sorted_sources_[ tid ].resize( kernel().model_manager.get_num_synapse_prototypes(), 0 );
+  num_communicated_sources_[ tid ].resize( kernel().model_manager.get_num_synapse_prototypes(), 0 );
+  unsorted_index_[ tid ].resize( kernel().model_manager.get_num_synapse_prototypes() );
+  unsorted_index_begin_[ tid ].resize( kernel().model_manager.get_num_synapse_prototypes(), 0 );
+  unsorted_index_end_[ tid ].resize( kernel().model_manager.get_num_synapse_prototypes(), 0 );
+}
+
+void
+nest::SourceTable::mark_sources_sorted( const thread tid )
+{
+  for ( synindex syn_id = 0; syn_id < sources_[ tid ].size(); ++syn_id )
+  {
+    num_sorted_sources_[ tid ][ syn_id ] = sources_[ tid ][ syn_id ].size();
+    unsorted_index_[ tid ][ syn_id ].clear();
+    unsorted_index_begin_[ tid ][ syn_id ] = 0;
+    unsorted_index_end_[ tid ][ syn_id ] = 0;
+  }
+  num_disabled_sources_[ tid ] = 0;
+  mark_sources_communicated( tid );
+}
+
+void
+nest::SourceTable::mark_sources_communicated( const thread tid )
+{
+  for ( synindex syn_id = 0; syn_id < sources_[ tid ].size(); ++syn_id )
+  {
+    num_communicated_sources_[ tid ][ syn_id ] = sources_[ tid ][ syn_id ].size();
+  }
+}
+
+void
+nest::SourceTable::get_num_changed_sources( const thread tid,
+  size_t& num_sources,
+  size_t& num_unsorted,
+  size_t& num_disabled ) const
+{
+  num_sources = 0;
+  num_unsorted = 0;
+  for ( synindex syn_id = 0; syn_id < sources_[ tid ].size(); ++syn_id )
+  {
+    const size_t size = sources_[ tid ][ syn_id ].size();
+    num_sources += size;
+    num_unsorted += size - std::min( num_sorted_sources_[ tid ][ syn_id ], size );
+  }
+  num_disabled = num_disabled_sources_[ tid ];
 }
 
 bool
@@ -86,6 +86,43 @@ private:
    */
   PerThreadBoolIndicator saved_entry_point_;
 
+  /**
+   * Number of leading entries per thread and synapse type that are
+   * sorted by source node ID. Sources added afterwards, e.g., by
+   * structural plasticity, are appended unsorted.
+   */
+  std::vector< std::vector< size_t > > num_sorted_sources_;
+
+  /**
+   * Number of leading entries per thread and synapse type whose
+   * targets have been communicated to the presynaptic side.
+   */
+  std::vector< std::vector< size_t > > num_communicated_sources_;
+
+  /**
+   * Number of entries per thread disabled since sources_ was last
+   * sorted.
+   */
+  std::vector< size_t > num_disabled_sources_;
+
+  /**
+   * Index of the unsorted part of sources_ per thread and synapse
+   * type, mapping source node IDs to the positions of their entries in
+   * ascending order. It is extended when the unsorted part is searched
+   * and covers the entries from unsorted_index_begin_ to
+   * unsorted_index_end_.
+   */
+  mutable std::vector< std::vector< std::map< index, std::vector< index > > > > unsorted_index_;
+  mutable std::vector< std::vector< size_t > > unsorted_index_begin_;
+  mutable std::vector< std::vector< size_t > > unsorted_index_end_;
+
+  /**
+   * Adds the entries appended to the unsorted part of sources_ since
+   * the last update to unsorted_index_, rebuilding the index if the
+   * sorted part has changed.
+   */
+  void update_unsorted_index_( const thread tid, const synindex syn_id ) const;
+
   /**
    * Minimal number of sources that need to be deleted per synapse
    * type and thread before a reallocation of the respective vector
@@ -232,10 +269,47 @@ public:
 
   /**
    * Finds the first entry in sources_ at the given thread id and
-   * synapse type that is equal to snode_id.
+   * synapse type that is equal to snode_id. Entries in the sorted part
+   * of sources_ are found by binary search, those in the unsorted part
+   * through an index of their source node IDs.
    */
   index find_first_source( const thread tid, const synindex syn_id, const index snode_id ) const;
 
+  /**
+   * Finds the next enabled entry after lcid in the unsorted part of
+   * sources_ that is equal to snode_id. Each of these entries is a
+   * connection of its own that is not chained to other connections of
+   * snode_id.
+   */
+  index find_next_unsorted_source( const thread tid,
+    const synindex syn_id,
+    const index snode_id,
+    const index lcid ) const;
+
+  /**
+   * Marks all entries of this thread as sorted and their targets as
+   * communicated. Called after sorting and removing disabled entries.
+   */
+  void mark_sources_sorted( const thread tid );
+
+  /**
+   * Marks the targets of all entries of this thread as communicated.
+   */
+  void mark_sources_communicated( const thread tid );
+
+  /**
+   * Returns the number of leading entries whose targets have been
+   * communicated to the presynaptic side.
+   */
+  size_t get_num_communicated_sources( const thread tid, const synindex syn_id ) const;
+
+  /**
+   * Returns the number of entries on this thread, the number of
+   * entries outside of the sorted part, and the number of entries
+   * disabled since the last sort.
+   */
+  void get_num_changed_sources( const thread tid, size_t& num_sources, size_t& num_unsorted, size_t& num_disabled ) const;
+
   /**
    * Marks entry in sources_ at given position as disabled.
    */
@@ -291,6 +365,11 @@ SourceTable::clear( const thread tid )
     it->clear();
   }
   sources_[ tid ].clear();
+  num_sorted_sources_[ tid ].clear();
+  num_communicated_sources_[ tid ].clear();
+  unsorted_index_[ tid ].clear();
+  unsorted_index_begin_[ tid ].clear();
+  unsorted_index_end_[ tid ].clear();
   is_cleared_[ tid ].set_true();
 }
 
@@ -392,27 +471,100 @@ SourceTable::no_targets_to_process( const thread tid )
 inline index
 SourceTable::find_first_source( const thread tid, const synindex syn_id, const index snode_id ) const
 {
+  const BlockVector< Source >& sources = sources_[ tid ][ syn_id ];
+  const size_t num_sorted = std::min( num_sorted_sources_[ tid ][ syn_id ], sources.size() );
+
   // binary search in sorted sources
-  const BlockVector< Source >::const_iterator begin = sources_[ tid ][ syn_id ].begin();
-  const BlockVector< Source >::const_iterator end = sources_[ tid ][ syn_id ].end();
+  const BlockVector< Source >::const_iterator begin = sources.begin();
+  const BlockVector< Source >::const_iterator end = begin + num_sorted;
   BlockVector< Source >::const_iterator it = std::lower_bound( begin, end, Source( snode_id, true ) );
 
   // source found by binary search could be disabled, iterate through
-  // sources until a valid one is found
+  // sources until a valid one is found; all enabled sources behind a
+  // larger node ID are larger as well
   while ( it != end )
   {
-    if ( it->get_node_id() == snode_id and not it->is_disabled() )
+    if ( not it->is_disabled() )
     {
-      const index lcid = it - begin;
-      return lcid;
+      if ( it->get_node_id() == snode_id )
+      {
+        const index lcid = it - begin;
+        return lcid;
+      }
+      if ( it->get_node_id() > snode_id )
+      {
+        break;
+      }
     }
     ++it;
   }
 
+  if ( num_sorted == 0 )
+  {
+    return find_next_unsorted_source( tid, syn_id, snode_id, invalid_index );
+  }
+  return find_next_unsorted_source( tid, syn_id, snode_id, num_sorted - 1 );
+}
+
+inline index
+SourceTable::find_next_unsorted_source( const thread tid,
+  const synindex syn_id,
+  const index snode_id,
+  const index lcid ) const
+{
+  update_unsorted_index_( tid, syn_id );
+
+  const std::map< index, std::vector< index > >::const_iterator entries =
+    unsorted_index_[ tid ][ syn_id ].find( snode_id );
+  if ( entries == unsorted_index_[ tid ][ syn_id ].end() )
+  {
+    return invalid_index;
+  }
+
+  // invalid_index marks a search from the start of the unsorted part
+  const std::vector< index >& lcids = entries->second;
+  std::vector< index >::const_iterator it =
+    lcid == invalid_index ? lcids.begin() : std::upper_bound( lcids.begin(), lcids.end(), lcid );
+  for ( ; it != lcids.end(); ++it )
+  {
+    if ( not sources_[ tid ][ syn_id ][ *it ].is_disabled() )
+    {
+      return *it;
+    }
+  }
+
   // no enabled entry with this snode ID found
   return invalid_index;
 }
 
+inline void
+SourceTable::update_unsorted_index_( const thread tid, const synindex syn_id ) const
+{
+  const BlockVector< Source >& sources = sources_[ tid ][ syn_id ];
+  const size_t num_sorted = std::min( num_sorted_sources_[ tid ][ syn_id ], sources.size() );
+  std::map< index, std::vector< index > >& unsorted_index = unsorted_index_[ tid ][ syn_id ];
+  size_t& begin = unsorted_index_begin_[ tid ][ syn_id ];
+  size_t& end = unsorted_index_end_[ tid ][ syn_id ];
+
+  if ( begin != num_sorted or end > sources.size() )
+  {
+    unsorted_index.clear();
+    begin = num_sorted;
+    end = num_sorted;
+  }
+
+  for ( ; end < sources.size(); ++end )
+  {
+    unsorted_index[ sources[ end ].get_node_id() ].push_back( end );
+  }
+}
+
+inline size_t
+SourceTable::get_num_communicated_sources( const thread tid, const synindex syn_id ) const
+{
+  return std::min( num_communicated_sources_[ tid ][ syn_id ], sources_[ tid ][ syn_id ].size() );
+}
+
 inline void
 SourceTable::disable_connection( const thread tid, const synindex syn_id, const index lcid )
 {
@@ -420,6 +572,7 @@ SourceTable::disable_connection( const thread tid, const synindex syn_id, const
   // source here
   assert( not sources_[ tid ][ syn_id ][ lcid ].is_disabled() );
   sources_[ tid ][ syn_id ][ lcid ].disable();
+  ++num_disabled_sources_[ tid ];
 }
 
 inline void
@@ -31,6 +31,8 @@
 
 // C++ includes:
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 
 // Includes from nestkernel:
 #include "conn_builder.h"
@@ -38,6 +40,7 @@
 #include "connector_base.h"
 #include "connector_model.h"
 #include "kernel_manager.h"
+#include "mpi_manager_impl.h"
 #include "nest_names.h"
 
 namespace nest
@@ -62,6 +65,7 @@ SPManager::SPManager()
   , sp_conn_builders_()
   , growthcurvedict_( new Dictionary() )
   , growthcurve_factories_()
+  , calcium_traces_()
 {
 }
 
@@ -75,6 +79,7 @@ SPManager::initialize()
 {
   structural_plasticity_update_interval_ = 10000.;
   structural_plasticity_enabled_ = false;
+  calcium_traces_.resize( kernel().vp_manager.get_num_threads() );
 }
 
 void
@@ -85,6 +90,13 @@ SPManager::finalize()
     delete *i;
   }
   sp_conn_builders_.clear();
+  calcium_traces_.clear();
+}
+
+void
+SPManager::change_num_threads( thread num_threads )
+{
+  calcium_traces_.resize( num_threads );
 }
 
 /*
@@ -333,6 +345,11 @@ SPManager::update_structural_plasticity()
  * structural plasticity is enabled. Retrieves the number of available
  * synaptic elements to create new synapses. Retrieves the number of
  * deleted synaptic elements to delete already created synapses.
+ *
+ * Only the nodes losing pre synaptic elements are communicated to all
+ * ranks, as their synapses are stored on the ranks of the targets. All
+ * other steps exchange per-rank element counts and the node IDs of the
+ * created or deleted synapses.
  * @param sp_builder The structural plasticity connection builder to use
  */
 void
@@ -348,16 +365,14 @@ SPManager::update_structural_plasticity( SPBuilder* sp_builder )
   std::vector< index > pre_deleted_id, post_deleted_id;
   std::vector< int > pre_deleted_n, post_deleted_n;
 
-  // Global vector for vacant and deleted synaptic element
-  std::vector< index > pre_vacant_id_global, post_vacant_id_global;
-  std::vector< int > pre_vacant_n_global, post_vacant_n_global;
-  std::vector< index > pre_deleted_id_global, post_deleted_id_global;
-  std::vector< int > pre_deleted_n_global, post_deleted_n_global;
+  // Global vector for deleted pre synaptic elements
+  std::vector< index > pre_deleted_id_global;
+  std::vector< int > pre_deleted_n_global;
 
   // Vector of displacements for communication
   std::vector< int > displacements;
 
-  // Get pre synaptic elements data from global nodes
+  // Get pre synaptic elements data from local nodes
   get_synaptic_elements(
     sp_builder->get_pre_synaptic_element_name(), pre_vacant_id, pre_vacant_n, pre_deleted_id, pre_deleted_n );
 
@@ -372,48 +387,37 @@ SPManager::update_structural_plasticity( SPBuilder* sp_builder )
       sp_builder->get_synapse_model(),
       sp_builder->get_pre_synaptic_element_name(),
       sp_builder->get_post_synaptic_element_name() );
-    // update the number of synaptic elements
-    get_synaptic_elements(
-      sp_builder->get_pre_synaptic_element_name(), pre_vacant_id, pre_vacant_n, pre_deleted_id, pre_deleted_n );
   }
-  // Get post synaptic elements data from local nodes
+
+  // Get post synaptic elements data from local nodes, the synapses to
+  // delete are chosen on the rank of their target
   get_synaptic_elements(
     sp_builder->get_post_synaptic_element_name(), post_vacant_id, post_vacant_n, post_deleted_id, post_deleted_n );
-  // Communicate the number of deleted post-synaptic elements
-  kernel().mpi_manager.communicate( post_deleted_id, post_deleted_id_global, displacements );
-  kernel().mpi_manager.communicate( post_deleted_n, post_deleted_n_global, displacements );
-
-  if ( post_deleted_id_global.size() > 0 )
-  {
-    delete_synapses_from_post( post_deleted_id_global,
-      post_deleted_n_global,
-      sp_builder->get_synapse_model(),
-      sp_builder->get_pre_synaptic_element_name(),
-      sp_builder->get_post_synaptic_element_name() );
-    get_synaptic_elements(
-      sp_builder->get_pre_synaptic_element_name(), pre_vacant_id, pre_vacant_n, pre_deleted_id, pre_deleted_n );
-    get_synaptic_elements(
-      sp_builder->get_post_synaptic_element_name(), post_vacant_id, post_vacant_n, post_deleted_id, post_deleted_n );
-  }
+  delete_synapses_from_post( post_deleted_id,
+    post_deleted_n,
+    sp_builder->get_synapse_model(),
+    sp_builder->get_pre_synaptic_element_name(),
+    sp_builder->get_post_synaptic_element_name() );
 
-  // Communicate vacant elements
-  kernel().mpi_manager.communicate( pre_vacant_id, pre_vacant_id_global, displacements );
-  kernel().mpi_manager.communicate( pre_vacant_n, pre_vacant_n_global, displacements );
-  kernel().mpi_manager.communicate( post_vacant_id, post_vacant_id_global, displacements );
-  kernel().mpi_manager.communicate( post_vacant_n, post_vacant_n_global, displacements );
+  // update the number of synaptic elements
+  get_synaptic_elements(
+    sp_builder->get_pre_synaptic_element_name(), pre_vacant_id, pre_vacant_n, pre_deleted_id, pre_deleted_n );
+  get_synaptic_elements(
+    sp_builder->get_post_synaptic_element_name(), post_vacant_id, post_vacant_n, post_deleted_id, post_deleted_n );
 
-  if ( pre_vacant_id_global.size() > 0 and post_vacant_id_global.size() > 0 )
-  {
-    create_synapses(
-      pre_vacant_id_global, pre_vacant_n_global, post_vacant_id_global, post_vacant_n_global, sp_builder );
-  }
+  create_synapses( pre_vacant_id, pre_vacant_n, post_vacant_id, post_vacant_n, sp_builder );
 }
 
 /**
- * Dynamic creation of synapses
- * @param pre_id source id
+ * Dynamic creation of synapses. The vacant elements are paired by a
+ * distributed random matching: from the number of vacant elements on each
+ * rank, all ranks draw the same assignment of new synapses to pairs of
+ * ranks with the global random number generator. Each rank then chooses
+ * the elements it contributes from its local nodes and sends the chosen
+ * sources to the ranks of their targets.
+ * @param pre_id ids of local nodes with vacant pre synaptic elements
  * @param pre_n number of available synaptic elements in the pre node
- * @param post_id target id
+ * @param post_id ids of local nodes with vacant post synaptic elements
  * @param post_n number of available synaptic elements in the post node
  * @param sp_conn_builder structural plasticity connection builder to use
  */
@@ -427,28 +431,93 @@ SPManager::create_synapses( std::vector< index >& pre_id,
   std::vector< index > pre_id_rnd;
   std::vector< index > post_id_rnd;
 
-  // shuffle the vacant element
   serialize_id( pre_id, pre_n, pre_id_rnd );
   serialize_id( post_id, post_n, post_id_rnd );
 
-  // Shuffle only the largest vector
-  if ( pre_id_rnd.size() > post_id_rnd.size() )
+  const thread num_processes = kernel().mpi_manager.get_num_processes();
+  const thread rank = kernel().mpi_manager.get_rank();
+
+  // Number of vacant elements on each rank
+  std::vector< int > pre_vacant_per_rank( num_processes, 0 );
+  std::vector< int > post_vacant_per_rank( num_processes, 0 );
+  pre_vacant_per_rank[ rank ] = pre_id_rnd.size();
+  post_vacant_per_rank[ rank ] = post_id_rnd.size();
+  kernel().mpi_manager.communicate( pre_vacant_per_rank );
+  kernel().mpi_manager.communicate( post_vacant_per_rank );
+
+  const long n_pre = std::accumulate( pre_vacant_per_rank.begin(), pre_vacant_per_rank.end(), 0L );
+  const long n_post = std::accumulate( post_vacant_per_rank.begin(), post_vacant_per_rank.end(), 0L );
+  const long n_synapses = std::min( n_pre, n_post );
+  if ( n_synapses == 0 )
   {
-    // we only shuffle the n first items,
-    // where n is the number of post synaptic elements
-    global_shuffle( pre_id_rnd, post_id_rnd.size() );
-    pre_id_rnd.resize( post_id_rnd.size() );
+    return;
   }
-  else
+
+  // Draw the number of pre and post synaptic elements taken from each
+  // rank, then the number of synapses between each pair of ranks, row by
+  // row from the post synaptic elements not yet paired. All ranks draw
+  // the same counts with the global rng; send_counts is the row of this
+  // rank and holds the number of local pre synaptic elements paired with
+  // post synaptic elements on each rank.
+  std::vector< int > pre_per_rank;
+  std::vector< int > post_per_rank;
+  draw_per_rank_( n_synapses, pre_vacant_per_rank, pre_per_rank );
+  draw_per_rank_( n_synapses, post_vacant_per_rank, post_per_rank );
+  const size_t n_recv = post_per_rank[ rank ];
+
+  std::vector< int > send_counts;
+  std::vector< int > synapses_per_rank;
+  for ( thread r = 0; r < num_processes; ++r )
+  {
+    draw_per_rank_( pre_per_rank[ r ], post_per_rank, synapses_per_rank );
+    for ( thread s = 0; s < num_processes; ++s )
+    {
+      post_per_rank[ s ] -= synapses_per_rank[ s ];
+    }
+    if ( r == rank )
+    {
+      send_counts = synapses_per_rank;
+    }
+  }
+
+  // choose the local pre synaptic elements, grouped by the rank of their
+  // target
+  const size_t n_send = std::accumulate( send_counts.begin(), send_counts.end(), 0 );
+  local_shuffle( pre_id_rnd, n_send );
+  pre_id_rnd.resize( n_send );
+
+  // synapses created on other ranks update their source here
+  const thread tid = kernel().vp_manager.get_thread_id();
+  std::vector< index >::const_iterator pre_it = pre_id_rnd.begin();
+  for ( thread r = 0; r < num_processes; ++r )
   {
-    // we only shuffle the n first items,
-    // where n is the number of pre synaptic elements
-    global_shuffle( post_id_rnd, pre_id_rnd.size() );
-    post_id_rnd.resize( pre_id_rnd.size() );
+    if ( r == rank )
+    {
+      pre_it += send_counts[ r ];
+      continue;
+    }
+    for ( int i = 0; i < send_counts[ r ]; ++i, ++pre_it )
+    {
+      Node* const source = kernel().node_manager.get_node_or_proxy( *pre_it );
+      if ( source->get_thread() == tid )
+      {
+        source->connect_synaptic_element( sp_conn_builder->get_pre_synaptic_element_name(), 1 );
+      }
+    }
   }
 
+  std::vector< index > pre_id_recv;
+  std::vector< int > recv_counts;
+  kernel().mpi_manager.communicate_Alltoallv( pre_id_rnd, send_counts, pre_id_recv, recv_counts );
+  assert( pre_id_recv.size() == n_recv );
+
+  // pair the received sources with randomly chosen local post synaptic
+  // elements
+  local_shuffle( post_id_rnd, n_recv );
+  post_id_rnd.resize( n_recv );
+
   // create synapse
-  sp_conn_builder->sp_connect( pre_id_rnd, post_id_rnd );
+  sp_conn_builder->sp_connect( pre_id_recv, post_id_rnd );
 }
 
 /**
@@ -469,84 +538,82 @@ SPManager::delete_synapses_from_pre( const std::vector< index >& pre_deleted_id,
   const std::string& se_post_name )
 {
   /*
-   * Synapses deletion due to the loss of a pre-synaptic element need a
-   * communication of the lists of target
+   * The synapses of a node losing pre-synaptic elements are stored on the
+   * ranks of their targets. Only the number of local targets is
+   * communicated, from which all ranks draw the number of synapses each
+   * rank deletes.
    */
 
   // Connectivity
   std::vector< std::vector< index > > connectivity;
-  std::vector< index > global_targets;
+  std::vector< int > n_targets_global;
   std::vector< int > displacements;
 
-  // iterators
-  std::vector< std::vector< index > >::iterator connectivity_it;
-  std::vector< index >::const_iterator id_it;
-  std::vector< int >::iterator n_it;
-
   kernel().connection_manager.get_targets( pre_deleted_id, synapse_model, se_post_name, connectivity );
 
-  id_it = pre_deleted_id.begin();
-  n_it = pre_deleted_n.begin();
-  connectivity_it = connectivity.begin();
-  for ( ; id_it != pre_deleted_id.end() and n_it != pre_deleted_n.end(); id_it++, n_it++, connectivity_it++ )
+  std::vector< int > n_targets_local( pre_deleted_id.size() );
+  for ( size_t i = 0; i < pre_deleted_id.size(); ++i )
   {
-    // Communicate the list of targets
-    kernel().mpi_manager.communicate( *connectivity_it, global_targets, displacements );
-    // shuffle only the first n items, n is the number of deleted synaptic
-    // elements
-    if ( -( *n_it ) > static_cast< int >( global_targets.size() ) )
+    n_targets_local[ i ] = connectivity[ i ].size();
+  }
+  kernel().mpi_manager.communicate( n_targets_local, n_targets_global, displacements );
+
+  const thread num_processes = kernel().mpi_manager.get_num_processes();
+  const thread rank = kernel().mpi_manager.get_rank();
+  const thread tid = kernel().vp_manager.get_thread_id();
+  std::vector< int > n_targets_per_rank( num_processes );
+  std::vector< int > n_deleted_per_rank;
+
+  for ( size_t i = 0; i < pre_deleted_id.size(); ++i )
+  {
+    long n_targets = 0;
+    for ( thread r = 0; r < num_processes; ++r )
     {
-      *n_it = -global_targets.size();
+      n_targets_per_rank[ r ] = n_targets_global[ displacements[ r ] + i ];
+      n_targets += n_targets_per_rank[ r ];
     }
-    global_shuffle( global_targets, -( *n_it ) );
+    // n is negative
+    const long n_deleted = std::min( static_cast< long >( -pre_deleted_n[ i ] ), n_targets );
 
-    for ( int i = 0; i < -( *n_it ); ++i ) // n is negative
+    draw_per_rank_( n_deleted, n_targets_per_rank, n_deleted_per_rank );
+    const size_t n_deleted_local = n_deleted_per_rank[ rank ];
+
+    if ( kernel().node_manager.is_local_node_id( pre_deleted_id[ i ] ) )
     {
-      delete_synapse( *id_it, global_targets[ i ], synapse_model, se_pre_name, se_post_name );
+      Node* const source = kernel().node_manager.get_node_or_proxy( pre_deleted_id[ i ] );
+      if ( source->get_thread() == tid )
+      {
+        source->connect_synaptic_element( se_pre_name, -n_deleted );
+      }
+    }
+
+    std::vector< index >& targets = connectivity[ i ];
+    local_shuffle( targets, n_deleted_local );
+    for ( size_t k = 0; k < n_deleted_local; ++k )
+    {
+      delete_synapse_at_target_( pre_deleted_id[ i ], targets[ k ], synapse_model, se_post_name );
     }
   }
 }
 
 /**
- * Handles the deletion of synapses between source and target nodes. The
- * deletion is defined by the pre and post synaptic elements and the synapse
- * type. Updates the number of connected synaptic elements in the source and
- * target.
- * @param snode_id source id
- * @param tnode_id target id
- * @param syn_id synapse type
- * @param se_pre_name name of the pre synaptic element
- * @param se_post_name name of the post synaptic element
+ * Deletes a synapse on the thread of its local target and updates the
+ * number of connected post synaptic elements of the target.
  */
 void
-SPManager::delete_synapse( const index snode_id,
+SPManager::delete_synapse_at_target_( const index snode_id,
   const index tnode_id,
   const long syn_id,
-  const std::string se_pre_name,
-  const std::string se_post_name )
+  const std::string& se_post_name )
 {
-  // get thread id
-  const int tid = kernel().vp_manager.get_thread_id();
-  if ( kernel().node_manager.is_local_node_id( snode_id ) )
+  const thread tid = kernel().vp_manager.get_thread_id();
+  Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id );
+  const thread target_thread = target->get_thread();
+  if ( tid == target_thread )
   {
-    Node* const source = kernel().node_manager.get_node_or_proxy( snode_id );
-    const thread source_thread = source->get_thread();
-    if ( tid == source_thread )
-    {
-      source->connect_synaptic_element( se_pre_name, -1 );
-    }
-  }
+    kernel().connection_manager.disconnect( tid, syn_id, snode_id, tnode_id );
 
-  if ( kernel().node_manager.is_local_node_id( tnode_id ) )
-  {
-    Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id );
-    const thread target_thread = target->get_thread();
-    if ( tid == target_thread )
-    {
-      kernel().connection_manager.disconnect( tid, syn_id, snode_id, tnode_id );
-
-      target->connect_synaptic_element( se_post_name, -1 );
-    }
+    target->connect_synaptic_element( se_post_name, -1 );
   }
 }
 
@@ -554,7 +621,8 @@ SPManager::delete_synapse( const index snode_id,
  * Deletion of synapses due to the loss of a post synaptic element. The
  * corresponding pre synaptic element will still remain available for a new
  * connection on the following updates in connectivity
- * @param post_deleted_id Id of the node with the deleted post synaptic element
+ * @param post_deleted_id Id of the local node with the deleted post synaptic
+ * element
  * @param post_deleted_n number of deleted post synaptic elements
  * @param synapse_model model name
  * @param se_pre_name pre synaptic element name
@@ -568,43 +636,53 @@ SPManager::delete_synapses_from_post( std::vector< index >& post_deleted_id,
   std::string se_post_name )
 {
   /*
-   * TODO: Synapses deletion due to the loss of a post-synaptic element can
-   * be done locally (except for the update of the number of pre-synaptic
-   * element)
+   * Synapses deletion due to the loss of a post-synaptic element is done
+   * locally, only the sources of the deleted synapses are sent to their
+   * ranks to update the number of pre-synaptic elements.
    */
 
   // Connectivity
   std::vector< std::vector< index > > connectivity;
-  std::vector< index > global_sources;
-  std::vector< int > displacements;
-
-  // iterators
-  std::vector< std::vector< index > >::iterator connectivity_it;
-  std::vector< index >::iterator id_it;
-  std::vector< int >::iterator n_it;
 
   // Retrieve the connected sources
   kernel().connection_manager.get_sources( post_deleted_id, synapse_model, connectivity );
 
-  id_it = post_deleted_id.begin();
-  n_it = post_deleted_n.begin();
-  connectivity_it = connectivity.begin();
+  const thread num_processes = kernel().mpi_manager.get_num_processes();
+  std::vector< std::vector< index > > deleted_sources( num_processes );
 
-  for ( ; id_it != post_deleted_id.end() and n_it != post_deleted_n.end(); id_it++, n_it++, connectivity_it++ )
+  for ( size_t i = 0; i < post_deleted_id.size(); ++i )
   {
-    // Communicate the list of sources
-    kernel().mpi_manager.communicate( *connectivity_it, global_sources, displacements );
-    // shuffle only the first n items, n is the number of deleted synaptic
-    // elements
-    if ( -( *n_it ) > static_cast< int >( global_sources.size() ) )
+    std::vector< index >& sources = connectivity[ i ];
+    // n is negative
+    const size_t n_deleted = std::min( static_cast< size_t >( -post_deleted_n[ i ] ), sources.size() );
+    local_shuffle( sources, n_deleted );
+
+    for ( size_t k = 0; k < n_deleted; ++k )
     {
-      *n_it = -global_sources.size();
+      delete_synapse_at_target_( sources[ k ], post_deleted_id[ i ], synapse_model, se_post_name );
+      deleted_sources[ kernel().mpi_manager.get_process_id_of_node_id( sources[ k ] ) ].push_back( sources[ k ] );
     }
-    global_shuffle( global_sources, -( *n_it ) );
+  }
+
+  std::vector< index > send_buffer;
+  std::vector< int > send_counts( num_processes );
+  for ( thread r = 0; r < num_processes; ++r )
+  {
+    send_counts[ r ] = deleted_sources[ r ].size();
+    send_buffer.insert( send_buffer.end(), deleted_sources[ r ].begin(), deleted_sources[ r ].end() );
+  }
 
-    for ( int i = 0; i < -( *n_it ); i++ ) // n is negative
+  std::vector< index > recv_buffer;
+  std::vector< int > recv_counts;
+  kernel().mpi_manager.communicate_Alltoallv( send_buffer, send_counts, recv_buffer, recv_counts );
+
+  const thread tid = kernel().vp_manager.get_thread_id();
+  for ( std::vector< index >::const_iterator it = recv_buffer.begin(); it != recv_buffer.end(); ++it )
+  {
+    Node* const source = kernel().node_manager.get_node_or_proxy( *it );
+    if ( source->get_thread() == tid )
     {
-      delete_synapse( global_sources[ i ], *id_it, synapse_model, se_pre_name, se_post_name );
+      source->connect_synaptic_element( se_pre_name, -1 );
     }
   }
 }
@@ -621,6 +699,8 @@ nest::SPManager::get_synaptic_elements( std::string se_name,
   index n_deleted_id = 0;
   index node_id;
   int n;
+  // convert the element name once rather than once per node
+  const Name se = se_name;
   size_t n_nodes = kernel().node_manager.size();
   se_vacant_id.clear();
   se_vacant_n.clear();
@@ -646,7 +726,7 @@ nest::SPManager::get_synaptic_elements( std::string se_name,
     {
       node_id = node_it->get_node_id();
       Node* node = node_it->get_node();
-      n = node->get_synaptic_elements_vacant( se_name );
+      n = node->get_synaptic_elements_vacant( se );
       if ( n > 0 )
       {
         ( *vacant_id_it ) = node_id;
@@ -690,36 +770,114 @@ nest::SPManager::serialize_id( std::vector< index >& id, std::vector< int >& n,
   }
 }
 
+/*
+ * Moves n randomly chosen items of v to its front, in random order, using
+ * the random number generator of the calling thread.
+ */
 void
-nest::SPManager::global_shuffle( std::vector< index >& v )
+nest::SPManager::local_shuffle( std::vector< index >& v, size_t n )
 {
-  global_shuffle( v, v.size() );
+  assert( n <= v.size() );
+
+  librandom::RngPtr rng = kernel().rng_manager.get_rng( kernel().vp_manager.get_thread_id() );
+  for ( size_t i = 0; i < n; ++i )
+  {
+    const size_t j = i + rng->ulrand( v.size() - i );
+    std::swap( v[ i ], v[ j ] );
+  }
 }
 
 /*
- * Shuffles the n first items of the vector v
+ * Draws how many of n_draws elements, drawn without replacement, come from
+ * each rank, with n_elements[ r ] elements available on rank r. The
+ * counts follow the multivariate hypergeometric distribution and are drawn
+ * rank by rank with the global random number generator, so all ranks
+ * obtain the same counts.
  */
 void
-nest::SPManager::global_shuffle( std::vector< index >& v, size_t n )
+nest::SPManager::draw_per_rank_( const long n_draws, const std::vector< int >& n_elements, std::vector< int >& n_drawn )
 {
-  assert( n <= v.size() );
+  librandom::RngPtr grng = kernel().rng_manager.get_grng();
+
+  long n_remaining = std::accumulate( n_elements.begin(), n_elements.end(), 0L );
+  long n_draws_remaining = n_draws;
+  assert( n_draws <= n_remaining );
+
+  n_drawn.assign( n_elements.size(), 0 );
+  for ( size_t r = 0; r < n_elements.size() and n_draws_remaining > 0; ++r )
+  {
+    n_drawn[ r ] = draw_hypergeometric_( grng, n_draws_remaining, n_elements[ r ], n_remaining );
+    n_draws_remaining -= n_drawn[ r ];
+    n_remaining -= n_elements[ r ];
+  }
+}
+
+/*
+ * Draws the number of marked elements among n_draws elements drawn without
+ * replacement from n_total elements, n_marked of which are marked. The
+ * cumulative distribution is inverted starting from the mode, so the
+ * expected number of steps grows with the standard deviation only.
+ */
+long
+nest::SPManager::draw_hypergeometric_( librandom::RngPtr& rng,
+  const long n_draws,
+  const long n_marked,
+  const long n_total )
+{
+  const long low = std::max( 0L, n_draws - ( n_total - n_marked ) );
+  const long high = std::min( n_draws, n_marked );
+  if ( low == high )
+  {
+    return low;
+  }
+
+  const long mode =
+    std::min( high, std::max( low, static_cast< long >( ( n_draws + 1.0 ) * ( n_marked + 1.0 ) / ( n_total + 2.0 ) ) ) );
+
+  // probability of the mode, from the logarithm of the binomial coefficients
+  const double p_mode = std::exp( std::lgamma( n_marked + 1.0 ) - std::lgamma( mode + 1.0 )
+    - std::lgamma( n_marked - mode + 1.0 ) + std::lgamma( n_total - n_marked + 1.0 )
+    - std::lgamma( n_draws - mode + 1.0 ) - std::lgamma( n_total - n_marked - n_draws + mode + 1.0 )
+    - std::lgamma( n_total + 1.0 ) + std::lgamma( n_draws + 1.0 ) + std::lgamma( n_total - n_draws + 1.0 ) );
+
+  double u = rng->drand() - p_mode;
+  if ( u < 0 )
+  {
+    return mode;
+  }
+
+  long lower = mode;
+  long upper = mode;
+  double p_lower = p_mode;
+  double p_upper = p_mode;
+  while ( lower > low or upper < high )
+  {
+    if ( upper < high )
+    {
+      p_upper *= static_cast< double >( n_marked - upper ) * ( n_draws - upper )
+        / ( ( upper + 1.0 ) * ( n_total - n_marked - n_draws + upper + 1.0 ) );
+      ++upper;
+      u -= p_upper;
+      if ( u < 0 )
+      {
+        return upper;
+      }
+    }
+    if ( lower > low )
+    {
+      p_lower *= static_cast< double >( lower ) * ( n_total - n_marked - n_draws + lower )
+        / ( ( n_marked - lower + 1.0 ) * ( n_draws - lower + 1.0 ) );
+      --lower;
+      u -= p_lower;
+      if ( u < 0 )
+      {
+        return lower;
+      }
+    }
+  }
 
-  // shuffle res using the global random number generator
-  unsigned int N = v.size();
-  std::vector< index > v2;
-  index tmp;
-  unsigned int rnd;
-  std::vector< index >::iterator rndi;
-  for ( unsigned int i = 0; i < n; i++ )
-  {
-    N = v.size();
-    rnd = kernel().rng_manager.get_grng()->ulrand( N );
-    tmp = v[ rnd ];
-    v2.push_back( tmp );
-    rndi = v.begin();
-    v.erase( rndi + rnd );
-  }
-  v = v2;
+  // only reached through rounding errors in the probabilities
+  return mode;
 }
 
 
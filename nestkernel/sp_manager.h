@@ -36,6 +36,9 @@
 // Includes from libnestutil:
 #include "manager_interface.h"
 
+// Includes from librandom:
+#include "randomgen.h"
+
 // Includes from nestkernel:
 #include "node_collection.h"
 #include "growth_curve_factory.h"
@@ -68,12 +71,20 @@ public:
 
   virtual void initialize();
   virtual void finalize();
+  virtual void change_num_threads( thread );
 
   virtual void get_status( DictionaryDatum& );
   virtual void set_status( const DictionaryDatum& );
 
   DictionaryDatum& get_growthcurvedict();
 
+  /**
+   * Buffer for the calcium trace which nodes on thread tid compute once per
+   * update of their synaptic elements and share between all elements whose
+   * growth curve integrates the calcium concentration numerically.
+   */
+  std::vector< double >& get_calcium_trace( thread tid );
+
   /**
    * Create a new Growth Curve object using the GrowthCurve Factory
    * @param name which defines the type of NC to be created
@@ -164,8 +175,6 @@ public:
     index synapse_model,
     std::string se_pre_name,
     std::string se_post_name );
-  // Deletion of synapses
-  void delete_synapse( index source, index target, long syn_id, std::string se_pre_name, std::string se_post_name );
 
   void get_synaptic_elements( std::string se_name,
     std::vector< index >& se_vacant_id,
@@ -174,10 +183,16 @@ public:
     std::vector< int >& se_deleted_n );
 
   void serialize_id( std::vector< index >& id, std::vector< int >& n, std::vector< index >& res );
-  void global_shuffle( std::vector< index >& v );
-  void global_shuffle( std::vector< index >& v, size_t n );
+  void local_shuffle( std::vector< index >& v, size_t n );
 
 private:
+  // Deletion of a synapse on the rank of its target
+  void delete_synapse_at_target_( index source, index target, long syn_id, const std::string& se_post_name );
+  // Number of elements drawn without replacement from each rank
+  void draw_per_rank_( long n_draws, const std::vector< int >& n_elements, std::vector< int >& n_drawn );
+  // Hypergeometric random variate
+  long draw_hypergeometric_( librandom::RngPtr& rng, long n_draws, long n_marked, long n_total );
+
   /**
    * Time interval for structural plasticity update (creation/deletion of
    * synapses).
@@ -204,6 +219,11 @@ private:
    * GrowthCurve factories, indexed by growthcurvedict_ elements.
    */
   std::vector< GenericGrowthCurveFactory* > growthcurve_factories_;
+
+  /**
+   * Per-thread calcium traces, see get_calcium_trace().
+   */
+  std::vector< std::vector< double > > calcium_traces_;
 };
 
 inline DictionaryDatum&
@@ -219,6 +239,12 @@ SPManager::new_growth_curve( Name name )
   return growthcurve_factories_.at( nc_id )->create();
 }
 
+inline std::vector< double >&
+SPManager::get_calcium_trace( thread tid )
+{
+  return calcium_traces_[ tid ];
+}
+
 inline bool
 SPManager::is_structural_plasticity_enabled() const
 {
@@ -22,6 +22,9 @@
 
 #include "sparse_node_array.h"
 
+// C++ includes:
+#include <algorithm>
+
 // Includes from nestkernel:
 #include "exceptions.h"
 #include "node.h"
@@ -35,6 +38,7 @@ nest::SparseNodeArray::NodeEntry::NodeEntry( Node& node, index node_id )
 
 nest::SparseNodeArray::SparseNodeArray()
   : nodes_()
+  , node_id_ranges_()
   , max_node_id_( 0 )
   , local_min_node_id_( 0 )
   , local_max_node_id_( 0 )
@@ -64,6 +68,24 @@ nest::SparseNodeArray::add_local_node( Node& node )
 
   // all is consistent, register node and update auxiliary variables
   nodes_.push_back( NodeEntry( node, node_id ) );
+
+  // extend the last node ID range if the node continues it
+  if ( not node_id_ranges_.empty()
+    and ( node_id_ranges_.back().size == 1
+      or node_id == node_id_ranges_.back().first_node_id
+          + node_id_ranges_.back().size * node_id_ranges_.back().stride ) )
+  {
+    NodeIDRange& range = node_id_ranges_.back();
+    if ( range.size == 1 )
+    {
+      range.stride = node_id - range.first_node_id;
+    }
+    ++range.size;
+  }
+  else
+  {
+    node_id_ranges_.push_back( { node_id, 1, 1, nodes_.size() - 1 } );
+  }
   if ( local_min_node_id_ == 0 ) // only first non-zero
   {
     local_min_node_id_ = node_id;
@@ -109,6 +131,55 @@ nest::SparseNodeArray::get_node_by_node_id( index node_id ) const
     return 0;
   }
 
+  if ( node_id_ranges_.size() * min_nodes_per_range <= nodes_.size() )
+  {
+    return get_node_in_ranges_( node_id );
+  }
+  return search_node_( node_id );
+}
+
+void
+nest::SparseNodeArray::filter_local( const std::vector< index >& node_ids,
+  std::vector< NodeEntry >& local_entries ) const
+{
+  for ( const index node_id : node_ids )
+  {
+    Node* node = get_node_by_node_id( node_id );
+    if ( node )
+    {
+      local_entries.push_back( NodeEntry( *node, node_id ) );
+    }
+  }
+}
+
+nest::Node*
+nest::SparseNodeArray::get_node_in_ranges_( index node_id ) const
+{
+  // find the last range starting at or before node_id, which exists
+  // since node_id is not below the smallest local node ID
+  auto range = std::upper_bound( node_id_ranges_.begin(),
+    node_id_ranges_.end(),
+    node_id,
+    []( const index id, const NodeIDRange& r )
+    {
+      return id < r.first_node_id;
+    } );
+  assert( range != node_id_ranges_.begin() );
+  --range;
+
+  const index distance = node_id - range->first_node_id;
+  if ( distance % range->stride == 0 and distance / range->stride < range->size )
+  {
+    const size_t idx = range->first_index + distance / range->stride;
+    assert( nodes_[ idx ].node_id_ == node_id );
+    return nodes_[ idx ].node_;
+  }
+  return 0;
+}
+
+nest::Node*
+nest::SparseNodeArray::search_node_( index node_id ) const
+{
   // now estimate index
   size_t idx = std::floor( node_id_idx_scale_ * ( node_id - local_min_node_id_ ) );
   assert( idx < nodes_.size() );
@@ -26,6 +26,7 @@
 // C++ includes:
 #include <cassert>
 #include <map>
+#include <vector>
 
 // Includes from nestkernel:
 #include "nest_types.h"
@@ -54,6 +55,11 @@ class Node;
  * will be skewed due to nodes without proxies present on all ranks, whence
  * computation may give an index that is too low and we must search to the right
  * for the actual node. We never need to search to the left.
+ *
+ * Nodes created together have node IDs with a fixed stride on each thread.
+ * The array therefore also records ranges of node IDs with fixed stride,
+ * which map a node ID directly to its index. The search above is only used
+ * if the node IDs are too fragmented into ranges, e.g., by many devices.
  */
 class SparseNodeArray
 {
@@ -113,6 +119,16 @@ public:
    */
   Node* get_node_by_node_id( index ) const;
 
+  /**
+   * Lookup local nodes for a batch of node IDs.
+   *
+   * Appends an entry for each given node ID that is local to the
+   * thread of this array, in the order of the given node IDs.
+   *
+   * @see get_node_by_node_id()
+   */
+  void filter_local( const std::vector< index >& node_ids, std::vector< NodeEntry >& local_entries ) const;
+
   /**
    * Lookup node based on index into container.
    *
@@ -134,12 +150,41 @@ public:
    */
   index get_max_node_id() const;
 
+  /**
+   * Use the search instead of the node ID ranges if there are fewer local
+   * nodes per range than this on average.
+   */
+  static const size_t min_nodes_per_range = 4;
+
 private:
-  BlockVector< NodeEntry > nodes_; //!< stores local node information
-  index max_node_id_;              //!< largest node ID in network
-  index local_min_node_id_;        //!< smallest local node ID
-  index local_max_node_id_;        //!< largest local node ID
-  double node_id_idx_scale_;       //!< interpolation factor
+  /**
+   * Local nodes with node IDs first_node_id + k * stride for k < size,
+   * stored at consecutive indices starting at first_index.
+   */
+  struct NodeIDRange
+  {
+    index first_node_id;
+    index stride;
+    size_t size;
+    size_t first_index;
+  };
+
+  /**
+   * Lookup node in the node ID ranges.
+   */
+  Node* get_node_in_ranges_( index ) const;
+
+  /**
+   * Lookup node by searching from the interpolated index.
+   */
+  Node* search_node_( index ) const;
+
+  BlockVector< NodeEntry > nodes_;            //!< stores local node information
+  std::vector< NodeIDRange > node_id_ranges_; //!< node ID ranges of local nodes
+  index max_node_id_;                         //!< largest node ID in network
+  index local_min_node_id_;                   //!< smallest local node ID
+  index local_max_node_id_;                   //!< largest local node ID
+  double node_id_idx_scale_;                  //!< interpolation factor
 };
 
 } // namespace nest
@@ -166,6 +211,7 @@ inline void
 nest::SparseNodeArray::clear()
 {
   nodes_.clear();
+  node_id_ranges_.clear();
   max_node_id_ = 0;
   local_min_node_id_ = 0;
   local_max_node_id_ = 0;
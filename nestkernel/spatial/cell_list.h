@@ -0,0 +1,247 @@
+/*
+ *  cell_list.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ */
+
+#ifndef CELL_LIST_H
+#define CELL_LIST_H
+
+// C++ includes:
+#include <bitset>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Includes from nestkernel:
+#include "nest_types.h"
+
+// Includes from spatial:
+#include "position.h"
+
+namespace nest
+{
+
+template < int D >
+class Mask;
+
+/**
+ * Spatial index used to find the nodes inside a mask when connecting.
+ * With automatic, a CellList is used where CellList::is_suitable()
+ * and CellList::is_uniform() hold, and an Ntree otherwise.
+ */
+enum class SpatialIndex
+{
+  automatic,
+  ntree,
+  cell_list
+};
+
+/**
+ * A CellList divides the region covered by a layer into a uniform grid
+ * of cells and stores the nodes ordered by the cell they are positioned
+ * in, with the nodes of each cell stored contiguously. Nodes inside a mask
+ * are found by scanning the cells overlapping the bounding box of the
+ * mask. For dense layers with roughly uniformly distributed nodes this is
+ * cheaper than the traversal of an Ntree.
+ *
+ * Periodic boundary conditions are handled as in Ntree, by applying the
+ * mask at the images of the anchor needed to cover the layer.
+ */
+template < int D, class T >
+class CellList
+{
+public:
+  typedef std::pair< Position< D >, T > value_type;
+
+  /**
+   * Minimal number of nodes for which a CellList is used automatically.
+   */
+  static const size_t min_nodes = 1024;
+
+  /**
+   * Average number of nodes per cell.
+   */
+  static const size_t nodes_per_cell = 4;
+
+  /**
+   * Largest number of nodes in a cell relative to the average for which
+   * the nodes are considered to be distributed uniformly.
+   */
+  static const size_t max_cell_load_factor = 16;
+
+  /**
+   * Number of nodes of a cell checked against the mask in one batch.
+   */
+  static const size_t mask_batch_size = 32;
+
+  /**
+   * Iterator over the nodes inside a mask. The nodes are visited cell by
+   * cell, with the first dimension varying fastest.
+   */
+  class masked_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair< Position< D >, T >;
+    using pointer = value_type*;
+    using reference = value_type&;
+    using difference_type = long int;
+
+    masked_iterator()
+      : cell_list_( 0 )
+      , mask_( 0 )
+      , current_anchor_( 0 )
+      , node_( 0 )
+      , cell_end_( 0 )
+      , batch_begin_( 0 )
+      , batch_end_( 0 )
+    {
+    }
+
+    masked_iterator( CellList& cell_list, const Mask< D >& mask, const Position< D >& anchor );
+
+    value_type& operator*()
+    {
+      return cell_list_->nodes_[ node_ ];
+    }
+    value_type* operator->()
+    {
+      return &cell_list_->nodes_[ node_ ];
+    }
+
+    masked_iterator& operator++();
+
+    masked_iterator operator++( int )
+    {
+      masked_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==( const masked_iterator& other ) const
+    {
+      return ( other.cell_list_ == cell_list_ ) && ( other.node_ == node_ );
+    }
+    bool operator!=( const masked_iterator& other ) const
+    {
+      return ( other.cell_list_ != cell_list_ ) || ( other.node_ != node_ );
+    }
+
+  private:
+    void init_anchor_();
+
+    void enter_cell_();
+
+    void next_cell_();
+
+    void skip_outside_();
+
+    /**
+     * Check the next batch of nodes of the current cell, starting at node_.
+     */
+    void check_batch_();
+
+    CellList* cell_list_;
+    const Mask< D >* mask_;
+    std::vector< Position< D > > anchors_;
+    index current_anchor_;
+    Position< D > anchor_;
+    int first_cell_[ D ];
+    int last_cell_[ D ];
+    int cell_[ D ];
+    index node_;
+    index cell_end_;
+    index batch_begin_;              //!< first node of the checked batch
+    index batch_end_;                //!< end of the checked batch
+    bool inside_[ mask_batch_size ]; //!< mask results for the checked batch
+  };
+
+  /**
+   * Create a cell list for the given nodes.
+   * @param lower_left Lower left corner of the region covered.
+   * @param extent     Size of the region covered.
+   * @param periodic   Periodic boundary conditions.
+   * @param nodes      (position, node ID) pairs. Nodes positioned outside
+   *                   the region are assigned to the nearest border cell.
+   */
+  CellList( const Position< D >& lower_left,
+    const Position< D >& extent,
+    std::bitset< D > periodic,
+    const std::vector< value_type >& nodes );
+
+  masked_iterator
+  masked_begin( const Mask< D >& mask, const Position< D >& anchor )
+  {
+    return masked_iterator( *this, mask, anchor );
+  }
+
+  masked_iterator
+  masked_end()
+  {
+    return masked_iterator();
+  }
+
+  /**
+   * Check if a CellList is expected to find the nodes inside the given
+   * mask faster than an Ntree. This is the case for large layers and
+   * ball, box and ellipse masks covering a small part of the layer.
+   */
+  static bool is_suitable( const size_t num_nodes, const Position< D >& extent, const Mask< D >& mask );
+
+  /**
+   * Check if the nodes are distributed roughly uniformly over the cells,
+   * so that no cell holds far more nodes than the average.
+   */
+  bool is_uniform() const;
+
+private:
+  /**
+   * @returns the coordinate of the cell containing the given coordinate
+   *          in dimension i, not restricted to the grid of cells.
+   */
+  double cell_coordinate_( const double x, const int i ) const;
+
+  /**
+   * @returns the cell coordinate restricted to the grid of cells in dimension i.
+   */
+  int clamp_cell_( const double cell, const int i ) const;
+
+  /**
+   * @returns the index of the cell containing the position.
+   */
+  index cell_index_( const Position< D >& pos ) const;
+
+  Position< D > lower_left_;
+  Position< D > extent_;
+  Position< D > cell_extent_;
+  std::bitset< D > periodic_;
+  int num_cells_[ D ];
+  int cell_stride_[ D ];
+
+  std::vector< value_type > nodes_; //!< nodes ordered by cell
+  std::vector< index > cell_begin_; //!< index of the first node of each cell in nodes_, plus end
+
+  friend class masked_iterator;
+};
+
+} // namespace nest
+
+#endif
@@ -0,0 +1,342 @@
+/*
+ *  cell_list_impl.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ */
+
+#ifndef CELL_LIST_IMPL_H
+#define CELL_LIST_IMPL_H
+
+#include "cell_list.h"
+
+// C++ includes:
+#include <algorithm>
+#include <cmath>
+
+// Includes from spatial:
+#include "mask.h"
+
+namespace nest
+{
+
+template < int D, class T >
+CellList< D, T >::CellList( const Position< D >& lower_left,
+  const Position< D >& extent,
+  std::bitset< D > periodic,
+  const std::vector< value_type >& nodes )
+  : lower_left_( lower_left )
+  , extent_( extent )
+  , periodic_( periodic )
+{
+  // Cubic cells holding nodes_per_cell nodes on average
+  double volume = 1.0;
+  for ( int i = 0; i < D; ++i )
+  {
+    volume *= extent_[ i ];
+  }
+  const double cell_side =
+    std::pow( volume * nodes_per_cell / std::max( nodes.size(), static_cast< size_t >( 1 ) ), 1.0 / D );
+  const double max_cells_per_dimension = nodes.size() / nodes_per_cell + 1;
+
+  size_t num_cells = 1;
+  for ( int i = 0; i < D; ++i )
+  {
+    num_cells_[ i ] =
+      static_cast< int >( std::max( 1.0, std::min( std::floor( extent_[ i ] / cell_side ), max_cells_per_dimension ) ) );
+    cell_extent_[ i ] = extent_[ i ] / num_cells_[ i ];
+    cell_stride_[ i ] = num_cells;
+    num_cells *= num_cells_[ i ];
+  }
+
+  // Counting sort of the nodes by cell, keeping the order of nodes within a cell
+  std::vector< index > node_cells( nodes.size() );
+  cell_begin_.assign( num_cells + 1, 0 );
+  for ( size_t k = 0; k < nodes.size(); ++k )
+  {
+    node_cells[ k ] = cell_index_( nodes[ k ].first );
+    ++cell_begin_[ node_cells[ k ] + 1 ];
+  }
+  for ( size_t cell = 0; cell < num_cells; ++cell )
+  {
+    cell_begin_[ cell + 1 ] += cell_begin_[ cell ];
+  }
+
+  std::vector< index > next_in_cell( cell_begin_.begin(), cell_begin_.end() - 1 );
+  nodes_.resize( nodes.size() );
+  for ( size_t k = 0; k < nodes.size(); ++k )
+  {
+    nodes_[ next_in_cell[ node_cells[ k ] ]++ ] = nodes[ k ];
+  }
+}
+
+template < int D, class T >
+inline double
+CellList< D, T >::cell_coordinate_( const double x, const int i ) const
+{
+  return ( x - lower_left_[ i ] ) / cell_extent_[ i ];
+}
+
+template < int D, class T >
+inline int
+CellList< D, T >::clamp_cell_( const double cell, const int i ) const
+{
+  if ( cell < 0 )
+  {
+    return 0;
+  }
+  if ( cell >= num_cells_[ i ] )
+  {
+    return num_cells_[ i ] - 1;
+  }
+  return static_cast< int >( cell );
+}
+
+template < int D, class T >
+inline index
+CellList< D, T >::cell_index_( const Position< D >& pos ) const
+{
+  index cell = 0;
+  for ( int i = 0; i < D; ++i )
+  {
+    cell += clamp_cell_( std::floor( cell_coordinate_( pos[ i ], i ) ), i ) * cell_stride_[ i ];
+  }
+  return cell;
+}
+
+template < int D, class T >
+bool
+CellList< D, T >::is_suitable( const size_t num_nodes, const Position< D >& extent, const Mask< D >& mask )
+{
+  if ( num_nodes < min_nodes )
+  {
+    return false;
+  }
+
+  if ( not( dynamic_cast< const BallMask< D >* >( &mask ) or dynamic_cast< const BoxMask< D >* >( &mask )
+         or dynamic_cast< const EllipseMask< D >* >( &mask ) ) )
+  {
+    return false;
+  }
+
+  // Masks covering a large part of the layer visit most nodes with either index
+  const Box< D > bbox = mask.get_bbox();
+  double mask_volume = 1.0;
+  double layer_volume = 1.0;
+  for ( int i = 0; i < D; ++i )
+  {
+    mask_volume *= bbox.upper_right[ i ] - bbox.lower_left[ i ];
+    layer_volume *= extent[ i ];
+  }
+  return 4 * mask_volume <= layer_volume;
+}
+
+template < int D, class T >
+bool
+CellList< D, T >::is_uniform() const
+{
+  const size_t num_cells = cell_begin_.size() - 1;
+  const size_t max_nodes_in_cell = max_cell_load_factor * ( nodes_.size() / num_cells + 1 );
+  for ( size_t cell = 0; cell < num_cells; ++cell )
+  {
+    if ( cell_begin_[ cell + 1 ] - cell_begin_[ cell ] > max_nodes_in_cell )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template < int D, class T >
+CellList< D, T >::masked_iterator::masked_iterator( CellList< D, T >& cell_list,
+  const Mask< D >& mask,
+  const Position< D >& anchor )
+  : cell_list_( &cell_list )
+  , mask_( &mask )
+  , anchors_()
+  , current_anchor_( 0 )
+  , anchor_( anchor )
+  , node_( 0 )
+  , cell_end_( 0 )
+  , batch_begin_( 0 )
+  , batch_end_( 0 )
+{
+  if ( cell_list_->periodic_.any() )
+  {
+    // Images of the anchor as in Ntree::masked_iterator
+    const Box< D > mask_bb = mask_->get_bbox();
+    const Position< D >& lower_left = cell_list_->lower_left_;
+    const Position< D >& extent = cell_list_->extent_;
+
+    // Move lower left corner of mask into main image of layer
+    for ( int i = 0; i < D; ++i )
+    {
+      if ( cell_list_->periodic_[ i ] )
+      {
+        double x = std::fmod( anchor_[ i ] + mask_bb.lower_left[ i ] - lower_left[ i ], extent[ i ] );
+        if ( x < 0 )
+        {
+          x += extent[ i ];
+        }
+        anchor_[ i ] = x - mask_bb.lower_left[ i ] + lower_left[ i ];
+      }
+    }
+    anchors_.push_back( anchor_ );
+
+    // Add extra anchors for each dimension where this is needed
+    for ( int i = 0; i < D; ++i )
+    {
+      if ( cell_list_->periodic_[ i ] )
+      {
+        const size_t n = anchors_.size();
+        if ( ( anchor_[ i ] + mask_bb.upper_right[ i ] - lower_left[ i ] ) > extent[ i ] )
+        {
+          for ( size_t j = 0; j < n; ++j )
+          {
+            Position< D > p = anchors_[ j ];
+            p[ i ] -= extent[ i ];
+            anchors_.push_back( p );
+          }
+        }
+      }
+    }
+  }
+  else
+  {
+    anchors_.push_back( anchor_ );
+  }
+
+  init_anchor_();
+  skip_outside_();
+}
+
+template < int D, class T >
+void
+CellList< D, T >::masked_iterator::init_anchor_()
+{
+  anchor_ = anchors_[ current_anchor_ ];
+
+  // The range of cells is widened slightly, so that nodes on the border of
+  // the mask are found regardless of rounding.
+  const double margin = 1e-6;
+  const Box< D > mask_bb = mask_->get_bbox();
+  for ( int i = 0; i < D; ++i )
+  {
+    first_cell_[ i ] = cell_list_->clamp_cell_(
+      std::floor( cell_list_->cell_coordinate_( anchor_[ i ] + mask_bb.lower_left[ i ], i ) - margin ), i );
+    last_cell_[ i ] = cell_list_->clamp_cell_(
+      std::floor( cell_list_->cell_coordinate_( anchor_[ i ] + mask_bb.upper_right[ i ], i ) + margin ), i );
+    cell_[ i ] = first_cell_[ i ];
+  }
+  enter_cell_();
+}
+
+template < int D, class T >
+inline void
+CellList< D, T >::masked_iterator::enter_cell_()
+{
+  index cell = 0;
+  for ( int i = 0; i < D; ++i )
+  {
+    cell += cell_[ i ] * cell_list_->cell_stride_[ i ];
+  }
+  node_ = cell_list_->cell_begin_[ cell ];
+  cell_end_ = cell_list_->cell_begin_[ cell + 1 ];
+  batch_begin_ = node_;
+  batch_end_ = node_;
+}
+
+template < int D, class T >
+void
+CellList< D, T >::masked_iterator::next_cell_()
+{
+  for ( int i = 0; i < D; ++i )
+  {
+    if ( cell_[ i ] < last_cell_[ i ] )
+    {
+      ++cell_[ i ];
+      return enter_cell_();
+    }
+    cell_[ i ] = first_cell_[ i ];
+  }
+
+  // All cells visited for this anchor
+  ++current_anchor_;
+  if ( current_anchor_ < anchors_.size() )
+  {
+    init_anchor_();
+  }
+  else
+  {
+    // Done. Mark as invalid.
+    cell_list_ = 0;
+    node_ = 0;
+  }
+}
+
+template < int D, class T >
+void
+CellList< D, T >::masked_iterator::check_batch_()
+{
+  batch_begin_ = node_;
+  batch_end_ = std::min( node_ + mask_batch_size, cell_end_ );
+
+  Position< D > anchored_positions[ mask_batch_size ];
+  const size_t batch_size = batch_end_ - batch_begin_;
+  for ( size_t k = 0; k < batch_size; ++k )
+  {
+    anchored_positions[ k ] = cell_list_->nodes_[ batch_begin_ + k ].first;
+    anchored_positions[ k ] -= anchor_;
+  }
+  mask_->inside( anchored_positions, batch_size, inside_ );
+}
+
+template < int D, class T >
+void
+CellList< D, T >::masked_iterator::skip_outside_()
+{
+  while ( cell_list_ )
+  {
+    while ( node_ < cell_end_ )
+    {
+      if ( node_ >= batch_end_ )
+      {
+        check_batch_();
+      }
+      if ( inside_[ node_ - batch_begin_ ] )
+      {
+        return;
+      }
+      ++node_;
+    }
+    next_cell_();
+  }
+}
+
+template < int D, class T >
+typename CellList< D, T >::masked_iterator& CellList< D, T >::masked_iterator::operator++()
+{
+  ++node_;
+  skip_outside_();
+  return *this;
+}
+
+} // namespace nest
+
+#endif
@@ -31,6 +31,7 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
   , allow_oversized_( false )
   , number_of_connections_()
   , mask_()
+  , spatial_index_( SpatialIndex::ntree )
   , kernel_()
   , synapse_model_( kernel().model_manager.get_synapsedict()->lookup( "static_synapse" ) )
   , weight_()
@@ -74,6 +75,26 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
     {
       mask_ = NestModule::create_mask( dit->second );
     }
+    else if ( dit->first == names::spatial_index )
+    {
+      const std::string spatial_index = getValue< std::string >( dit->second );
+      if ( spatial_index == "auto" )
+      {
+        spatial_index_ = SpatialIndex::automatic;
+      }
+      else if ( spatial_index == "ntree" )
+      {
+        spatial_index_ = SpatialIndex::ntree;
+      }
+      else if ( spatial_index == "cell_list" )
+      {
+        spatial_index_ = SpatialIndex::cell_list;
+      }
+      else
+      {
+        throw BadProperty( "Spatial index must be 'auto', 'ntree' or 'cell_list'." );
+      }
+    }
     else if ( dit->first == names::kernel )
     {
       kernel_ = NestModule::create_parameter( dit->second );
@@ -123,6 +144,19 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
     }
   }
 
+  // Evaluate composite parameters as flat programs when connecting
+  for ( auto parameter : { &kernel_, &weight_, &delay_ } )
+  {
+    if ( parameter->get() )
+    {
+      Parameter* compiled = ( *parameter )->compile();
+      if ( compiled )
+      {
+        parameter->reset( compiled );
+      }
+    }
+  }
+
   if ( connection_type == names::pairwise_bernoulli_on_source )
   {
 
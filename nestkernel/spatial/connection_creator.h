@@ -32,6 +32,7 @@
 #include "nestmodule.h"
 
 // Includes from spatial:
+#include "cell_list.h"
 #include "mask.h"
 #include "position.h"
 #include "vose.h"
@@ -72,6 +73,31 @@ public:
     Fixed_outdegree
   };
 
+  /**
+   * Number of candidate sources for which connection probabilities are
+   * evaluated at once in pairwise Bernoulli connections.
+   */
+  static const size_t bernoulli_tile_size = 256;
+
+  /**
+   * Largest connection probability in a tile of candidates below which
+   * candidates are visited by geometric skipping.
+   */
+  static constexpr double bernoulli_skipping_threshold = 0.1;
+
+  /**
+   * Largest number of alias tables each thread keeps for targets at
+   * different positions relative to the grid of the source layer in
+   * fixed indegree connections.
+   */
+  static const size_t max_grid_lotteries = 64;
+
+  /**
+   * Number of consecutive sources whose targets are drawn with the same
+   * random generator in fixed outdegree connections.
+   */
+  static const size_t fixed_outdegree_chunk_size = 128;
+
   /**
    * Construct a ConnectionCreator with the properties defined in the
    * given dictionary. Parameters for a ConnectionCreator are:
@@ -88,6 +114,8 @@ public:
    * - "sources": Which targets (model or lid) to select (dictionary).
    * - "weight": Synaptic weight (dictionary, parametertype, or double).
    * - "delay": Synaptic delays (dictionary, parametertype, or double).
+   * - "spatial_index": Spatial index used to find the nodes inside the
+   *   mask, either "ntree" (default), "cell_list" or "auto".
    * - other parameters are interpreted as synapse parameters, and may
    *   be defined by a dictionary, parametertype, or double.
    * @param dict dictionary containing properties for the connections.
@@ -118,19 +146,65 @@ private:
     PoolWrapper_();
     ~PoolWrapper_();
     void define( MaskedLayer< D >* );
-    void define( std::vector< std::pair< Position< D >, index > >* );
+    void define( std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > );
 
     typename Ntree< D, index >::masked_iterator masked_begin( const Position< D >& pos ) const;
     typename Ntree< D, index >::masked_iterator masked_end() const;
 
-    typename std::vector< std::pair< Position< D >, index > >::iterator begin() const;
-    typename std::vector< std::pair< Position< D >, index > >::iterator end() const;
+    bool uses_cell_list() const;
+    typename CellList< D, index >::masked_iterator cell_list_begin( const Position< D >& pos ) const;
+    typename CellList< D, index >::masked_iterator cell_list_end() const;
+
+    typename std::vector< std::pair< Position< D >, index > >::const_iterator begin() const;
+    typename std::vector< std::pair< Position< D >, index > >::const_iterator end() const;
 
   private:
     MaskedLayer< D >* masked_layer_;
-    std::vector< std::pair< Position< D >, index > >* positions_;
+    std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > positions_;
   };
 
+  /**
+   * Compute kernel values for connections between candidate nodes and a node at a fixed position.
+   *
+   * Kernels that do not draw random numbers are evaluated for all candidates in a single call to
+   * Parameter::values(). Random kernels are evaluated one candidate after the other to keep the
+   * sequence of random numbers independent of the batching.
+   *
+   * @param candidates (position, node ID) pairs of the candidate nodes.
+   * @param fixed_pos position of the other node of all connections.
+   * @param candidates_are_sources whether the candidates are the sources of the connections.
+   * @param layer layer in which displacements are computed.
+   * @param values vector to store one kernel value per candidate in.
+   */
+  template < int D >
+  void get_kernel_values_( librandom::RngPtr& rng,
+    const std::vector< std::pair< Position< D >, index > >& candidates,
+    const std::vector< double >& fixed_pos,
+    const bool candidates_are_sources,
+    const Layer< D >& layer,
+    std::vector< double >& values ) const;
+
+  /**
+   * Connect the candidate source to the target, unless this would create a
+   * forbidden autapse.
+   */
+  template < int D >
+  void connect_candidate_( const std::pair< Position< D >, index >& candidate,
+    Node* tgt_ptr,
+    const std::vector< double >& target_pos,
+    thread tgt_thread,
+    librandom::RngPtr& rng,
+    const Layer< D >& source,
+    std::vector< double >& source_pos );
+
+  /**
+   * Connect sources in the range [from, to) to the target with the
+   * probability given by the kernel. For deterministic kernels, the
+   * sources are processed in tiles of bernoulli_tile_size candidates.
+   * If all probabilities in a tile are below bernoulli_skipping_threshold,
+   * the candidates are visited by geometric skipping instead of drawing
+   * one random number per candidate.
+   */
   template < typename Iterator, int D >
   void connect_to_target_( Iterator from,
     Iterator to,
@@ -151,10 +225,65 @@ private:
     Layer< D >& target,
     NodeCollectionPTR target_nc );
 
+  /**
+   * Alias table for drawing the sources of targets at the same position
+   * relative to the grid of a periodic grid source layer. The sources are
+   * stored as grid offsets from the grid cell containing the target.
+   */
+  template < int D >
+  struct GridLottery_
+  {
+    GridLottery_( const std::vector< Position< D, int > >& offsets, const std::vector< double >& probabilities )
+      : offsets( offsets )
+      , lottery( probabilities )
+    {
+    }
+
+    std::vector< Position< D, int > > offsets;
+    Vose lottery;
+  };
+
+  /**
+   * Draw number_of_connections_ sources among num_candidates candidates and
+   * connect them to the target, respecting the autapse and multapse rules.
+   * @param draw functor returning the index of a randomly drawn candidate.
+   * @param get_source functor taking a candidate index and a position
+   *        vector, storing the position of the candidate in the vector and
+   *        returning its node ID.
+   */
+  template < typename Draw, typename GetSource, int D >
+  void connect_drawn_sources_( const size_t num_candidates,
+    Draw draw,
+    GetSource get_source,
+    Node* tgt_ptr,
+    const std::vector< double >& target_pos,
+    thread tgt_thread,
+    librandom::RngPtr& rng,
+    const Layer< D >& source );
+
   template < int D >
   void
   fixed_indegree_( Layer< D >& source, NodeCollectionPTR source_nc, Layer< D >& target, NodeCollectionPTR target_nc );
 
+  /**
+   * Target drawn for a source in fixed outdegree connections, to be
+   * connected by the thread owning the target.
+   */
+  template < int D >
+  struct OutdegreeTarget_
+  {
+    OutdegreeTarget_( const size_t source_index, const index target_id, const Position< D >& target_pos )
+      : source_index( source_index )
+      , target_id( target_id )
+      , target_pos( target_pos )
+    {
+    }
+
+    size_t source_index; //!< index into the global source positions
+    index target_id;
+    Position< D > target_pos;
+  };
+
   template < int D >
   void
   fixed_outdegree_( Layer< D >& source, NodeCollectionPTR source_nc, Layer< D >& target, NodeCollectionPTR target_nc );
@@ -165,6 +294,7 @@ private:
   bool allow_oversized_;
   index number_of_connections_;
   std::shared_ptr< AbstractMask > mask_;
+  SpatialIndex spatial_index_;
   std::shared_ptr< Parameter > kernel_;
   index synapse_model_;
   std::shared_ptr< Parameter > weight_;
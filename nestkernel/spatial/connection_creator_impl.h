@@ -26,6 +26,11 @@
 #include "connection_creator.h"
 
 // C++ includes:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
 #include <vector>
 
 // Includes from librandom:
@@ -34,6 +39,10 @@
 // Includes from nestkernel:
 #include "kernel_manager.h"
 #include "nest.h"
+#include "vp_manager_impl.h"
+
+// Includes from spatial:
+#include "grid_layer.h"
 
 namespace nest
 {
@@ -71,6 +80,79 @@ ConnectionCreator::connect( Layer< D >& source,
   }
 }
 
+template < int D >
+void
+ConnectionCreator::get_kernel_values_( librandom::RngPtr& rng,
+  const std::vector< std::pair< Position< D >, index > >& candidates,
+  const std::vector< double >& fixed_pos,
+  const bool candidates_are_sources,
+  const Layer< D >& layer,
+  std::vector< double >& values ) const
+{
+  values.clear();
+  if ( candidates.empty() )
+  {
+    return;
+  }
+
+  if ( kernel_->is_random() )
+  {
+    std::vector< double > candidate_pos( D );
+    values.reserve( candidates.size() );
+    for ( const auto& candidate : candidates )
+    {
+      candidate.first.get_vector( candidate_pos );
+      values.push_back( candidates_are_sources ? kernel_->value( rng, candidate_pos, fixed_pos, layer )
+                                               : kernel_->value( rng, fixed_pos, candidate_pos, layer ) );
+    }
+    return;
+  }
+
+  std::vector< double > candidate_pos;
+  candidate_pos.reserve( candidates.size() * D );
+  for ( const auto& candidate : candidates )
+  {
+    for ( int i = 0; i < D; ++i )
+    {
+      candidate_pos.push_back( candidate.first[ i ] );
+    }
+  }
+
+  if ( candidates_are_sources )
+  {
+    kernel_->values( rng, candidate_pos, fixed_pos, layer, values );
+  }
+  else
+  {
+    kernel_->values( rng, fixed_pos, candidate_pos, layer, values );
+  }
+}
+
+template < int D >
+inline void
+ConnectionCreator::connect_candidate_( const std::pair< Position< D >, index >& candidate,
+  Node* tgt_ptr,
+  const std::vector< double >& target_pos,
+  thread tgt_thread,
+  librandom::RngPtr& rng,
+  const Layer< D >& source,
+  std::vector< double >& source_pos )
+{
+  if ( ( not allow_autapses_ ) and ( candidate.second == tgt_ptr->get_node_id() ) )
+  {
+    return;
+  }
+
+  candidate.first.get_vector( source_pos );
+  kernel().connection_manager.connect( candidate.second,
+    tgt_ptr,
+    tgt_thread,
+    synapse_model_,
+    dummy_param_dicts_[ tgt_thread ],
+    delay_->value( rng, source_pos, target_pos, source ),
+    weight_->value( rng, source_pos, target_pos, source ) );
+}
+
 template < typename Iterator, int D >
 void
 ConnectionCreator::connect_to_target_( Iterator from,
@@ -89,6 +171,75 @@ ConnectionCreator::connect_to_target_( Iterator from,
   const std::vector< double > target_pos = tgt_pos.get_vector();
 
   const bool without_kernel = not kernel_.get();
+
+  if ( not without_kernel and not kernel_->is_random() )
+  {
+    // Evaluate the kernel for tiles of sources at once. As the kernel draws
+    // no random numbers, the probabilities do not depend on the order of
+    // evaluation.
+    std::vector< std::pair< Position< D >, index > > tile;
+    tile.reserve( bernoulli_tile_size );
+    std::vector< double > probabilities;
+    std::vector< double > draws;
+
+    Iterator iter = from;
+    while ( iter != to )
+    {
+      tile.clear();
+      for ( ; iter != to and tile.size() < bernoulli_tile_size; ++iter )
+      {
+        tile.push_back( *iter );
+      }
+      get_kernel_values_( rng, tile, target_pos, true, source, probabilities );
+
+      const double max_probability = *std::max_element( probabilities.begin(), probabilities.end() );
+      if ( max_probability <= 0.0 )
+      {
+        continue;
+      }
+
+      if ( max_probability < bernoulli_skipping_threshold )
+      {
+        // Visit candidates by a Bernoulli process with the largest
+        // probability in the tile, drawing the number of candidates skipped
+        // from a geometric distribution, and accept each visited candidate
+        // with its own probability relative to the largest one.
+        const double log_q = std::log1p( -max_probability );
+        size_t i = 0;
+        while ( true )
+        {
+          const double skip = std::floor( std::log( rng->drandpos() ) / log_q );
+          if ( skip >= tile.size() - i )
+          {
+            break;
+          }
+          i += static_cast< size_t >( skip );
+          if ( rng->drand() * max_probability < probabilities[ i ] )
+          {
+            connect_candidate_( tile[ i ], tgt_ptr, target_pos, tgt_thread, rng, source, source_pos );
+          }
+          ++i;
+        }
+      }
+      else
+      {
+        draws.resize( tile.size() );
+        for ( auto& draw : draws )
+        {
+          draw = rng->drand();
+        }
+        for ( size_t i = 0; i < tile.size(); ++i )
+        {
+          if ( draws[ i ] < probabilities[ i ] )
+          {
+            connect_candidate_( tile[ i ], tgt_ptr, target_pos, tgt_thread, rng, source, source_pos );
+          }
+        }
+      }
+    }
+    return;
+  }
+
   for ( Iterator iter = from; iter != to; ++iter )
   {
     if ( ( not allow_autapses_ ) and ( iter->second == tgt_ptr->get_node_id() ) )
@@ -113,7 +264,7 @@ ConnectionCreator::connect_to_target_( Iterator from,
 template < int D >
 ConnectionCreator::PoolWrapper_< D >::PoolWrapper_()
   : masked_layer_( 0 )
-  , positions_( 0 )
+  , positions_()
 {
 }
 
@@ -131,18 +282,18 @@ void
 ConnectionCreator::PoolWrapper_< D >::define( MaskedLayer< D >* ml )
 {
   assert( masked_layer_ == 0 );
-  assert( positions_ == 0 );
+  assert( not positions_ );
   assert( ml != 0 );
   masked_layer_ = ml;
 }
 
 template < int D >
 void
-ConnectionCreator::PoolWrapper_< D >::define( std::vector< std::pair< Position< D >, index > >* pos )
+ConnectionCreator::PoolWrapper_< D >::define( std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > pos )
 {
   assert( masked_layer_ == 0 );
-  assert( positions_ == 0 );
-  assert( pos != 0 );
+  assert( not positions_ );
+  assert( pos );
   positions_ = pos;
 }
 
@@ -161,14 +312,35 @@ ConnectionCreator::PoolWrapper_< D >::masked_end() const
 }
 
 template < int D >
-typename std::vector< std::pair< Position< D >, index > >::iterator
+bool
+ConnectionCreator::PoolWrapper_< D >::uses_cell_list() const
+{
+  return masked_layer_->uses_cell_list();
+}
+
+template < int D >
+typename CellList< D, index >::masked_iterator
+ConnectionCreator::PoolWrapper_< D >::cell_list_begin( const Position< D >& pos ) const
+{
+  return masked_layer_->cell_list_begin( pos );
+}
+
+template < int D >
+typename CellList< D, index >::masked_iterator
+ConnectionCreator::PoolWrapper_< D >::cell_list_end() const
+{
+  return masked_layer_->cell_list_end();
+}
+
+template < int D >
+typename std::vector< std::pair< Position< D >, index > >::const_iterator
 ConnectionCreator::PoolWrapper_< D >::begin() const
 {
   return positions_->begin();
 }
 
 template < int D >
-typename std::vector< std::pair< Position< D >, index > >::iterator
+typename std::vector< std::pair< Position< D >, index > >::const_iterator
 ConnectionCreator::PoolWrapper_< D >::end() const
 {
   return positions_->end();
@@ -192,7 +364,7 @@ ConnectionCreator::pairwise_bernoulli_on_source_( Layer< D >& source,
   PoolWrapper_< D > pool;
   if ( mask_.get() ) // MaskedLayer will be freed by PoolWrapper d'tor
   {
-    pool.define( new MaskedLayer< D >( source, mask_, allow_oversized_, source_nc ) );
+    pool.define( new MaskedLayer< D >( source, mask_, allow_oversized_, source_nc, spatial_index_ ) );
   }
   else
   {
@@ -219,7 +391,12 @@ ConnectionCreator::pairwise_bernoulli_on_source_( Layer< D >& source,
         {
           const Position< D > target_pos = target.get_position( ( *tgt_it ).lid );
 
-          if ( mask_.get() )
+          if ( mask_.get() and pool.uses_cell_list() )
+          {
+            connect_to_target_(
+              pool.cell_list_begin( target_pos ), pool.cell_list_end(), tgt, target_pos, thread_id, source );
+          }
+          else if ( mask_.get() )
           {
             connect_to_target_(
               pool.masked_begin( target_pos ), pool.masked_end(), tgt, target_pos, thread_id, source );
@@ -271,7 +448,7 @@ ConnectionCreator::pairwise_bernoulli_on_target_( Layer< D >& source,
   {
     // By supplying the target layer to the MaskedLayer constructor, the
     // mask is mirrored so it may be applied to the source layer instead
-    pool.define( new MaskedLayer< D >( source, mask_, allow_oversized_, target, source_nc ) );
+    pool.define( new MaskedLayer< D >( source, mask_, allow_oversized_, target, source_nc, spatial_index_ ) );
   }
   else
   {
@@ -305,7 +482,14 @@ ConnectionCreator::pairwise_bernoulli_on_target_( Layer< D >& source,
 
         const Position< D > target_pos = target.get_position( ( *tgt_it ).lid );
 
-        if ( mask_.get() )
+        if ( mask_.get() and pool.uses_cell_list() )
+        {
+          // We do the same as in the target driven case, except that we calculate displacements in the target layer.
+          // We therefore send in target as last parameter.
+          connect_to_target_(
+            pool.cell_list_begin( target_pos ), pool.cell_list_end(), tgt, target_pos, thread_id, target );
+        }
+        else if ( mask_.get() )
         {
           // We do the same as in the target driven case, except that we calculate displacements in the target layer.
           // We therefore send in target as last parameter.
@@ -337,6 +521,50 @@ ConnectionCreator::pairwise_bernoulli_on_target_( Layer< D >& source,
   }
 }
 
+template < typename Draw, typename GetSource, int D >
+void
+ConnectionCreator::connect_drawn_sources_( const size_t num_candidates,
+  Draw draw,
+  GetSource get_source,
+  Node* tgt_ptr,
+  const std::vector< double >& target_pos,
+  thread tgt_thread,
+  librandom::RngPtr& rng,
+  const Layer< D >& source )
+{
+  const index target_id = tgt_ptr->get_node_id();
+  std::vector< double > source_pos( D );
+
+  // If multapses are not allowed, we must keep track of which
+  // sources have been selected already.
+  std::vector< bool > is_selected( num_candidates );
+
+  // Draw `number_of_connections_` sources
+  for ( int i = 0; i < ( int ) number_of_connections_; ++i )
+  {
+    const index random_id = draw();
+    if ( ( not allow_multapses_ ) and ( is_selected[ random_id ] ) )
+    {
+      --i;
+      continue;
+    }
+
+    const index source_id = get_source( random_id, source_pos );
+    if ( ( not allow_autapses_ ) and ( source_id == target_id ) )
+    {
+      --i;
+      continue;
+    }
+
+    const double w = weight_->value( rng, source_pos, target_pos, source );
+    const double d = delay_->value( rng, source_pos, target_pos, source );
+    kernel().connection_manager.connect(
+      source_id, tgt_ptr, tgt_thread, synapse_model_, dummy_param_dicts_[ tgt_thread ], d, w );
+
+    is_selected[ random_id ] = true;
+  }
+}
+
 template < int D >
 void
 ConnectionCreator::fixed_indegree_( Layer< D >& source,
@@ -355,6 +583,9 @@ ConnectionCreator::fixed_indegree_( Layer< D >& source,
   // 1. Apply Mask to source layer
   // 2. Compute connection probability for each source position
   // 3. Draw source nodes and make connections
+  //
+  // Each thread connects its own target nodes, drawing from the random
+  // number generator of its virtual process.
 
   // We only need to check the first in the NodeCollection
   Node* const first_in_tgt = kernel().node_manager.get_node_or_proxy( target_nc->operator[]( 0 ) );
@@ -363,258 +594,223 @@ ConnectionCreator::fixed_indegree_( Layer< D >& source,
     throw IllegalConnection( "Spatial Connect with fixed_indegree to devices is not possible." );
   }
 
-  NodeCollection::const_iterator target_begin = target_nc->MPI_local_begin();
-  NodeCollection::const_iterator target_end = target_nc->end();
-
   // protect against connecting to devices without proxies
   // we need to do this before creating the first connection to leave
   // the network untouched if any target does not have proxies
-  for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_end; ++tgt_it )
+  for ( NodeCollection::const_iterator tgt_it = target_nc->MPI_local_begin(); tgt_it < target_nc->end(); ++tgt_it )
   {
     Node* const tgt = kernel().node_manager.get_node_or_proxy( ( *tgt_it ).node_id );
 
     assert( not tgt->is_proxy() );
   }
 
+  std::unique_ptr< MaskedLayer< D > > masked_source;
+  std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > all_positions;
   if ( mask_.get() )
   {
-    MaskedLayer< D > masked_source( source, mask_, allow_oversized_, source_nc );
-    const auto masked_source_end = masked_source.end();
-
-    std::vector< std::pair< Position< D >, index > > positions;
+    masked_source.reset( new MaskedLayer< D >( source, mask_, allow_oversized_, source_nc, spatial_index_ ) );
+  }
+  else
+  {
+    // Get (position,node ID) pairs for all nodes in source layer
+    all_positions = source.get_global_positions_vector( source_nc );
+  }
 
-    for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_end; ++tgt_it )
+  // If the source layer is a periodic grid and the kernel depends only on
+  // the displacement between source and target, the sources found for a
+  // target and their probabilities only depend on the position of the
+  // target relative to the grid, up to a shift of the grid. We then build
+  // one alias table for each such relative position and reuse it, storing
+  // the sources as grid offsets from the grid cell of the target. The
+  // sources of a table keep the order in which the mask returned them for
+  // the first target at that relative position, which generally differs
+  // from the order for later targets. The connections drawn for a given
+  // seed thus differ from drawing for each target separately, while
+  // their distribution is the same.
+  GridLayer< D >* const grid_source = dynamic_cast< GridLayer< D >* >( &source );
+  bool reuse_lotteries = kernel_.get() and not kernel_->is_random() and not kernel_->uses_node_positions()
+    and grid_source and source.get_periodic_mask().count() == D;
+  if ( reuse_lotteries )
+  {
+    index grid_size = 1;
+    for ( int i = 0; i < D; ++i )
     {
-      index target_id = ( *tgt_it ).node_id;
-      Node* const tgt = kernel().node_manager.get_node_or_proxy( target_id );
-
-      thread target_thread = tgt->get_thread();
-      librandom::RngPtr rng = get_vp_rng( target_thread );
-      Position< D > target_pos = target.get_position( ( *tgt_it ).lid );
-
-      // We create a source pos vector here that can be updated with the
-      // source position. This is done to avoid creating and destroying
-      // unnecessarily many vectors.
-      std::vector< double > source_pos_vector( D );
-      const std::vector< double > target_pos_vector = target_pos.get_vector();
-
-      // Get (position,node ID) pairs for sources inside mask
-      positions.resize( std::distance( masked_source.begin( target_pos ), masked_source_end ) );
-      std::copy( masked_source.begin( target_pos ), masked_source_end, positions.begin() );
-
-      // We will select `number_of_connections_` sources within the mask.
-      // If there is no kernel, we can just draw uniform random numbers,
-      // but with a kernel we have to set up a probability distribution
-      // function using the Vose class.
-      if ( kernel_.get() )
-      {
-
-        std::vector< double > probabilities;
-        probabilities.reserve( positions.size() );
-
-        // Collect probabilities for the sources
-        for ( typename std::vector< std::pair< Position< D >, index > >::iterator iter = positions.begin();
-              iter != positions.end();
-              ++iter )
-        {
-          iter->first.get_vector( source_pos_vector );
-          probabilities.push_back( kernel_->value( rng, source_pos_vector, target_pos_vector, source ) );
-        }
+      grid_size *= grid_source->get_dims()[ i ];
+    }
+    // grid positions can only be mapped to node IDs for the entire layer
+    reuse_lotteries = source_nc->size() == grid_size;
+  }
 
-        if ( positions.empty()
-          or ( ( not allow_autapses_ ) and ( positions.size() == 1 ) and ( positions[ 0 ].second == target_id ) )
-          or ( ( not allow_multapses_ ) and ( positions.size() < number_of_connections_ ) ) )
-        {
-          std::string msg = String::compose( "Global target ID %1: Not enough sources found inside mask", target_id );
-          throw KernelException( msg.c_str() );
-        }
+  const std::string not_enough_sources_msg = mask_.get() ? "Global target ID %1: Not enough sources found inside mask"
+                                                         : "Global target ID %1: Not enough sources found";
 
-        // A Vose object draws random integers with a non-uniform
-        // distribution.
-        Vose lottery( probabilities );
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised_( kernel().vp_manager.get_num_threads() );
 
-        // If multapses are not allowed, we must keep track of which
-        // sources have been selected already.
-        std::vector< bool > is_selected( positions.size() );
+// sharing specs on next line commented out because gcc 4.2 cannot handle them
+#pragma omp parallel // default(none) shared(source, target, masked_source,
+                     // all_positions)
+  {
+    const int thread_id = kernel().vp_manager.get_thread_id();
+    try
+    {
+      librandom::RngPtr rng = get_vp_rng( thread_id );
 
-        // Draw `number_of_connections_` sources
-        for ( int i = 0; i < ( int ) number_of_connections_; ++i )
-        {
-          index random_id = lottery.get_random_id( rng );
-          if ( ( not allow_multapses_ ) and ( is_selected[ random_id ] ) )
-          {
-            --i;
-            continue;
-          }
+      std::vector< std::pair< Position< D >, index > > masked_positions;
+      std::vector< double > probabilities;
+      std::map< std::vector< long >, GridLottery_< D > > lotteries;
 
-          index source_id = positions[ random_id ].second;
-          if ( ( not allow_autapses_ ) and ( source_id == target_id ) )
-          {
-            --i;
-            continue;
-          }
-          positions[ random_id ].first.get_vector( source_pos_vector );
-          const double w = weight_->value( rng, source_pos_vector, target_pos_vector, source );
-          const double d = delay_->value( rng, source_pos_vector, target_pos_vector, source );
-          kernel().connection_manager.connect(
-            source_id, tgt, target_thread, synapse_model_, dummy_param_dicts_[ target_thread ], d, w );
+      NodeCollection::const_iterator target_begin = target_nc->local_begin();
+      NodeCollection::const_iterator target_end = target_nc->end();
 
-          is_selected[ random_id ] = true;
-        }
-      }
-      else
+      for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_end; ++tgt_it )
       {
+        const index target_id = ( *tgt_it ).node_id;
+        Node* const tgt = kernel().node_manager.get_node_or_proxy( target_id, thread_id );
 
-        // no kernel
-
-        if ( positions.empty()
-          or ( ( not allow_autapses_ ) and ( positions.size() == 1 ) and ( positions[ 0 ].second == target_id ) )
-          or ( ( not allow_multapses_ ) and ( positions.size() < number_of_connections_ ) ) )
-        {
-          std::string msg = String::compose( "Global target ID %1: Not enough sources found inside mask", target_id );
-          throw KernelException( msg.c_str() );
-        }
+        assert( not tgt->is_proxy() );
 
-        // If multapses are not allowed, we must keep track of which
-        // sources have been selected already.
-        std::vector< bool > is_selected( positions.size() );
+        const Position< D > target_pos = target.get_position( ( *tgt_it ).lid );
+        const std::vector< double > target_pos_vector = target_pos.get_vector();
 
-        // Draw `number_of_connections_` sources
-        for ( int i = 0; i < ( int ) number_of_connections_; ++i )
+        auto check_num_sources = [&]( const size_t num_sources, const index first_source_id )
         {
-          index random_id = rng->ulrand( positions.size() );
-          if ( ( not allow_multapses_ ) and ( is_selected[ random_id ] ) )
+          if ( num_sources == 0
+            or ( ( not allow_autapses_ ) and ( num_sources == 1 ) and ( first_source_id == target_id ) )
+            or ( ( not allow_multapses_ ) and ( num_sources < number_of_connections_ ) ) )
           {
-            --i;
-            continue;
+            std::string msg = String::compose( not_enough_sources_msg, target_id );
+            throw KernelException( msg.c_str() );
           }
-          positions[ random_id ].first.get_vector( source_pos_vector );
-          index source_id = positions[ random_id ].second;
-          const double w = weight_->value( rng, source_pos_vector, target_pos_vector, source );
-          const double d = delay_->value( rng, source_pos_vector, target_pos_vector, source );
-          kernel().connection_manager.connect(
-            source_id, tgt, target_thread, synapse_model_, dummy_param_dicts_[ target_thread ], d, w );
-
-          is_selected[ random_id ] = true;
-        }
-      }
-    }
-  }
-  else
-  {
-    // no mask
-
-    // Get (position,node ID) pairs for all nodes in source layer
-    std::vector< std::pair< Position< D >, index > >* positions = source.get_global_positions_vector( source_nc );
-
-    for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_end; ++tgt_it )
-    {
-      index target_id = ( *tgt_it ).node_id;
-      Node* const tgt = kernel().node_manager.get_node_or_proxy( target_id );
-      thread target_thread = tgt->get_thread();
-      librandom::RngPtr rng = get_vp_rng( target_thread );
-      Position< D > target_pos = target.get_position( ( *tgt_it ).lid );
-
-      std::vector< double > source_pos_vector( D );
-      const std::vector< double > target_pos_vector = target_pos.get_vector();
-
-      if ( ( positions->size() == 0 )
-        or ( ( not allow_autapses_ ) and ( positions->size() == 1 ) and ( ( *positions )[ 0 ].second == target_id ) )
-        or ( ( not allow_multapses_ ) and ( positions->size() < number_of_connections_ ) ) )
-      {
-        std::string msg = String::compose( "Global target ID %1: Not enough sources found", target_id );
-        throw KernelException( msg.c_str() );
-      }
+        };
 
-      // We will select `number_of_connections_` sources within the mask.
-      // If there is no kernel, we can just draw uniform random numbers,
-      // but with a kernel we have to set up a probability distribution
-      // function using the Vose class.
-      if ( kernel_.get() )
-      {
-
-        std::vector< double > probabilities;
-        probabilities.reserve( positions->size() );
-
-        // Collect probabilities for the sources
-        for ( typename std::vector< std::pair< Position< D >, index > >::iterator iter = positions->begin();
-              iter != positions->end();
-              ++iter )
+        // Get (position,node ID) pairs for sources inside mask
+        auto get_candidates = [&]() -> const std::vector< std::pair< Position< D >, index > >&
         {
-          iter->first.get_vector( source_pos_vector );
-          probabilities.push_back( kernel_->value( rng, source_pos_vector, target_pos_vector, source ) );
-        }
-
-        // A Vose object draws random integers with a non-uniform
-        // distribution.
-        Vose lottery( probabilities );
-
-        // If multapses are not allowed, we must keep track of which
-        // sources have been selected already.
-        std::vector< bool > is_selected( positions->size() );
-
-        // Draw `number_of_connections_` sources
-        for ( int i = 0; i < ( int ) number_of_connections_; ++i )
+          if ( masked_source )
+          {
+            masked_source->get_positions( target_pos, masked_positions );
+            return masked_positions;
+          }
+          return *all_positions;
+        };
+
+        // Relative positions are identified up to a billionth of the grid
+        // spacing. If the targets are not aligned with the grid, only the
+        // first max_grid_lotteries relative positions get an alias table.
+        Position< D, int > target_gridpos;
+        auto lottery = lotteries.end();
+        if ( reuse_lotteries )
         {
-          index random_id = lottery.get_random_id( rng );
-          if ( ( not allow_multapses_ ) and ( is_selected[ random_id ] ) )
+          Position< D > offset;
+          target_gridpos = grid_source->position_to_gridpos( target_pos, offset );
+          std::vector< long > key( D );
+          for ( int i = 0; i < D; ++i )
           {
-            --i;
-            continue;
+            key[ i ] = std::lround( offset[ i ] * 1e9 );
           }
 
-          index source_id = ( *positions )[ random_id ].second;
-          if ( ( not allow_autapses_ ) and ( source_id == target_id ) )
+          lottery = lotteries.find( key );
+          if ( lottery == lotteries.end() and lotteries.size() < max_grid_lotteries )
           {
-            --i;
-            continue;
+            const std::vector< std::pair< Position< D >, index > >& candidates = get_candidates();
+            check_num_sources( candidates.size(), candidates.empty() ? 0 : candidates[ 0 ].second );
+
+            get_kernel_values_( rng, candidates, target_pos_vector, true, source, probabilities );
+
+            std::vector< Position< D, int > > offsets;
+            offsets.reserve( candidates.size() );
+            for ( const auto& candidate : candidates )
+            {
+              Position< D > candidate_offset;
+              offsets.push_back( grid_source->position_to_gridpos( candidate.first, candidate_offset ) - target_gridpos );
+            }
+            lottery = lotteries.insert( std::make_pair( key, GridLottery_< D >( offsets, probabilities ) ) ).first;
           }
-
-          ( *positions )[ random_id ].first.get_vector( source_pos_vector );
-          const double w = weight_->value( rng, source_pos_vector, target_pos_vector, source );
-          const double d = delay_->value( rng, source_pos_vector, target_pos_vector, source );
-          kernel().connection_manager.connect(
-            source_id, tgt, target_thread, synapse_model_, dummy_param_dicts_[ target_thread ], d, w );
-
-          is_selected[ random_id ] = true;
         }
-      }
-      else
-      {
-
-        // no kernel
-
-        // If multapses are not allowed, we must keep track of which
-        // sources have been selected already.
-        std::vector< bool > is_selected( positions->size() );
 
-        // Draw `number_of_connections_` sources
-        for ( int i = 0; i < ( int ) number_of_connections_; ++i )
+        if ( lottery != lotteries.end() )
         {
-          index random_id = rng->ulrand( positions->size() );
-          if ( ( not allow_multapses_ ) and ( is_selected[ random_id ] ) )
+          const GridLottery_< D >& grid_lottery = lottery->second;
+          auto get_source = [&]( const index random_id, std::vector< double >& source_pos ) -> index
           {
-            --i;
-            continue;
-          }
-
-          index source_id = ( *positions )[ random_id ].second;
-          if ( ( not allow_autapses_ ) and ( source_id == target_id ) )
-          {
-            --i;
-            continue;
-          }
+            const index lid = grid_source->gridpos_to_lid( target_gridpos + grid_lottery.offsets[ random_id ] );
+            grid_source->lid_to_position( lid ).get_vector( source_pos );
+            return ( *source_nc )[ lid ];
+          };
+
+          std::vector< double > first_source_pos( D );
+          check_num_sources(
+            grid_lottery.offsets.size(), grid_lottery.offsets.empty() ? 0 : get_source( 0, first_source_pos ) );
+
+          connect_drawn_sources_( grid_lottery.offsets.size(),
+            [&]() { return grid_lottery.lottery.get_random_id( rng ); },
+            get_source,
+            tgt,
+            target_pos_vector,
+            thread_id,
+            rng,
+            source );
+          continue;
+        }
 
-          ( *positions )[ random_id ].first.get_vector( source_pos_vector );
-          const double w = weight_->value( rng, source_pos_vector, target_pos_vector, source );
-          const double d = delay_->value( rng, source_pos_vector, target_pos_vector, source );
-          kernel().connection_manager.connect(
-            source_id, tgt, target_thread, synapse_model_, dummy_param_dicts_[ target_thread ], d, w );
+        const std::vector< std::pair< Position< D >, index > >& candidates = get_candidates();
+        check_num_sources( candidates.size(), candidates.empty() ? 0 : candidates[ 0 ].second );
 
-          is_selected[ random_id ] = true;
+        auto get_source = [&]( const index random_id, std::vector< double >& source_pos ) -> index
+        {
+          candidates[ random_id ].first.get_vector( source_pos );
+          return candidates[ random_id ].second;
+        };
+
+        // If there is no kernel, we can just draw uniform random numbers,
+        // but with a kernel we have to set up a probability distribution
+        // function using the Vose class.
+        if ( kernel_.get() )
+        {
+          // Collect probabilities for the sources
+          get_kernel_values_( rng, candidates, target_pos_vector, true, source, probabilities );
+
+          // A Vose object draws random integers with a non-uniform
+          // distribution.
+          const Vose lottery( probabilities );
+
+          connect_drawn_sources_( candidates.size(),
+            [&]() { return lottery.get_random_id( rng ); },
+            get_source,
+            tgt,
+            target_pos_vector,
+            thread_id,
+            rng,
+            source );
+        }
+        else
+        {
+          connect_drawn_sources_( candidates.size(),
+            [&]() { return rng->ulrand( candidates.size() ); },
+            get_source,
+            tgt,
+            target_pos_vector,
+            thread_id,
+            rng,
+            source );
         }
       }
     }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at
+      // the end of the catch block.
+      exceptions_raised_.at( thread_id ) =
+        std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+  } // omp parallel
+  // check if any exceptions have been raised
+  for ( thread thr = 0; thr < kernel().vp_manager.get_num_threads(); ++thr )
+  {
+    if ( exceptions_raised_.at( thr ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised_.at( thr ) ) );
+    }
   }
 }
 
@@ -657,99 +853,195 @@ ConnectionCreator::fixed_outdegree_( Layer< D >& source,
   // For each (global) source: (All connections made on all mpi procs)
   // 1. Apply mask to global targets
   // 2. If using kernel: Compute connection probability for each global target
-  // 3. Draw connections to make using global rng
+  // 3. Draw targets, keeping those local to this process
+  // 4. Each thread connects the targets it owns, drawing weights and delays
+  //    with the rng of its virtual process
+  //
+  // Sources are split into chunks of fixed_outdegree_chunk_size sources,
+  // which are distributed over the threads. The targets of each chunk are
+  // drawn with a generator seeded from a seed drawn once from the global
+  // rng and the chunk index, so all processes draw the same targets for a
+  // source, independent of the number of threads.
+
+  MaskedLayer< D > masked_target( target, mask_, allow_oversized_, target_nc, spatial_index_ );
+
+  // hold the positions, the cache entry may be dropped by later lookups
+  const std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > source_positions =
+    source.get_global_positions_vector( source_nc );
+  const std::vector< std::pair< Position< D >, index > >& source_pos_node_id_pairs = *source_positions;
+
+  const thread num_threads = kernel().vp_manager.get_num_threads();
+  const size_t num_chunks =
+    ( source_pos_node_id_pairs.size() + fixed_outdegree_chunk_size - 1 ) / fixed_outdegree_chunk_size;
+  const unsigned long base_seed = 1 + get_global_rng()->ulrand( std::numeric_limits< unsigned int >::max() );
+
+  // Generators for drawing targets, one per thread, of the type of the global rng
+  std::vector< librandom::RngPtr > target_rngs;
+  for ( thread thr = 0; thr < num_threads; ++thr )
+  {
+    target_rngs.push_back( get_global_rng()->clone( base_seed ) );
+  }
 
-  MaskedLayer< D > masked_target( target, mask_, allow_oversized_, target_nc );
-  const auto masked_target_end = masked_target.end();
+  // Drawn targets local to this process, by thread drawing them and thread
+  // owning the target
+  std::vector< std::vector< std::vector< OutdegreeTarget_< D > > > > drawn_targets(
+    num_threads, std::vector< std::vector< OutdegreeTarget_< D > > >( num_threads ) );
 
-  // We create a target positions vector here that can be updated with the
-  // position and node ID pairs. This is done to avoid creating and destroying
-  // unnecessarily many vectors.
-  std::vector< std::pair< Position< D >, index > > target_pos_node_id_pairs;
-  std::vector< std::pair< Position< D >, index > > source_pos_node_id_pairs =
-    *source.get_global_positions_vector( source_nc );
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised_( num_threads );
 
-  for ( const auto& source_pos_node_id_pair : source_pos_node_id_pairs )
+// sharing specs on next line commented out because gcc 4.2 cannot handle them
+#pragma omp parallel // default(none) shared(source, target, masked_target,
+                     // source_pos_node_id_pairs, drawn_targets)
   {
-    const Position< D > source_pos = source_pos_node_id_pair.first;
-    const index source_id = source_pos_node_id_pair.second;
-    const std::vector< double > source_pos_vector = source_pos.get_vector();
-
-    // We create a target pos vector here that can be updated with the
-    // target position. This is done to avoid creating and destroying
-    // unnecessarily many vectors.
-    std::vector< double > target_pos_vector( D );
-    std::vector< double > probabilities;
+    const thread thread_id = kernel().vp_manager.get_thread_id();
+    try
+    {
+      librandom::RngPtr& rng = target_rngs[ thread_id ];
 
-    // Find potential targets and probabilities
-    librandom::RngPtr rng = get_global_rng();
-    target_pos_node_id_pairs.resize( std::distance( masked_target.begin( source_pos ), masked_target_end ) );
-    std::copy( masked_target.begin( source_pos ), masked_target_end, target_pos_node_id_pairs.begin() );
+      // We create vectors here that can be updated for each source. This is
+      // done to avoid creating and destroying unnecessarily many vectors.
+      std::vector< std::pair< Position< D >, index > > target_pos_node_id_pairs;
+      std::vector< double > probabilities;
 
-    probabilities.reserve( target_pos_node_id_pairs.size() );
-    if ( kernel_.get() )
-    {
-      for ( const auto& target_pos_node_id_pair : target_pos_node_id_pairs )
+      for ( size_t chunk = thread_id; chunk < num_chunks; chunk += num_threads )
       {
-        // TODO: Why is probability calculated in source layer, but weight and delay in target layer?
-        target_pos_node_id_pair.first.get_vector( target_pos_vector );
-        probabilities.push_back( kernel_->value( rng, source_pos_vector, target_pos_vector, source ) );
+        rng->seed( base_seed + chunk );
+
+        const size_t chunk_end =
+          std::min( ( chunk + 1 ) * fixed_outdegree_chunk_size, source_pos_node_id_pairs.size() );
+        for ( size_t source_index = chunk * fixed_outdegree_chunk_size; source_index < chunk_end; ++source_index )
+        {
+          const Position< D >& source_pos = source_pos_node_id_pairs[ source_index ].first;
+          const index source_id = source_pos_node_id_pairs[ source_index ].second;
+          const std::vector< double > source_pos_vector = source_pos.get_vector();
+
+          // Find potential targets and probabilities
+          masked_target.get_positions( source_pos, target_pos_node_id_pairs );
+
+          if ( kernel_.get() )
+          {
+            // TODO: Why is probability calculated in source layer, but weight and delay in target layer?
+            get_kernel_values_( rng, target_pos_node_id_pairs, source_pos_vector, false, source, probabilities );
+          }
+          else
+          {
+            probabilities.assign( target_pos_node_id_pairs.size(), 1.0 );
+          }
+
+          if ( target_pos_node_id_pairs.empty()
+            or ( ( not allow_multapses_ ) and ( target_pos_node_id_pairs.size() < number_of_connections_ ) ) )
+          {
+            std::string msg = String::compose( "Global source ID %1: Not enough targets found", source_id );
+            throw KernelException( msg.c_str() );
+          }
+
+          // Draw targets.  A Vose object draws random integers with a
+          // non-uniform distribution.
+          Vose lottery( probabilities );
+
+          // If multapses are not allowed, we must keep track of which
+          // targets have been selected already.
+          std::vector< bool > is_selected( target_pos_node_id_pairs.size() );
+
+          // Draw `number_of_connections_` targets
+          for ( long i = 0; i < ( long ) number_of_connections_; ++i )
+          {
+            index random_id = lottery.get_random_id( rng );
+            if ( ( not allow_multapses_ ) and ( is_selected[ random_id ] ) )
+            {
+              --i;
+              continue;
+            }
+            index target_id = target_pos_node_id_pairs[ random_id ].second;
+            if ( ( not allow_autapses_ ) and ( source_id == target_id ) )
+            {
+              --i;
+              continue;
+            }
+
+            is_selected[ random_id ] = true;
+
+            // Targets on other processes are dropped right away, as no
+            // random numbers are drawn for the connection itself here.
+            if ( not kernel().node_manager.is_local_node_id( target_id ) )
+            {
+              continue;
+            }
+
+            const thread target_thread =
+              kernel().vp_manager.vp_to_thread( kernel().vp_manager.node_id_to_vp( target_id ) );
+            drawn_targets[ thread_id ][ target_thread ].push_back(
+              OutdegreeTarget_< D >( source_index, target_id, target_pos_node_id_pairs[ random_id ].first ) );
+          }
+        }
       }
     }
-    else
+    catch ( std::exception& err )
     {
-      probabilities.resize( target_pos_node_id_pairs.size(), 1.0 );
+      // We must create a new exception here, err's lifetime ends at
+      // the end of the catch block.
+      exceptions_raised_.at( thread_id ) =
+        std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
     }
 
-    if ( target_pos_node_id_pairs.empty()
-      or ( ( not allow_multapses_ ) and ( target_pos_node_id_pairs.size() < number_of_connections_ ) ) )
+    // Only connect once all targets are drawn, leaving the network untouched
+    // if not enough targets were found for any source.
+#pragma omp barrier
+
+    bool drawing_failed = false;
+    for ( thread thr = 0; thr < num_threads; ++thr )
     {
-      std::string msg = String::compose( "Global source ID %1: Not enough targets found", source_id );
-      throw KernelException( msg.c_str() );
+      drawing_failed = drawing_failed or exceptions_raised_.at( thr ).get();
     }
 
-    // Draw targets.  A Vose object draws random integers with a
-    // non-uniform distribution.
-    Vose lottery( probabilities );
-
-    // If multapses are not allowed, we must keep track of which
-    // targets have been selected already.
-    std::vector< bool > is_selected( target_pos_node_id_pairs.size() );
-
-    // Draw `number_of_connections_` targets
-    for ( long i = 0; i < ( long ) number_of_connections_; ++i )
+    if ( not drawing_failed )
     {
-      index random_id = lottery.get_random_id( get_global_rng() );
-      if ( ( not allow_multapses_ ) and ( is_selected[ random_id ] ) )
+      try
       {
-        --i;
-        continue;
-      }
-      index target_id = target_pos_node_id_pairs[ random_id ].second;
-      if ( ( not allow_autapses_ ) and ( source_id == target_id ) )
-      {
-        --i;
-        continue;
-      }
-
-      is_selected[ random_id ] = true;
+        librandom::RngPtr rng = get_vp_rng( thread_id );
 
-      target_pos_node_id_pairs[ random_id ].first.get_vector( target_pos_vector );
-      const double w = weight_->value( rng, source_pos_vector, target_pos_vector, target );
-      const double d = delay_->value( rng, source_pos_vector, target_pos_vector, target );
+        // We create a target pos vector here that can be updated with the
+        // target position. This is done to avoid creating and destroying
+        // unnecessarily many vectors.
+        std::vector< double > target_pos_vector( D );
 
-      // We bail out for non-local neurons only now after all possible
-      // random numbers haven been drawn. Bailing out any earlier may lead
-      // to desynchronized global rngs.
-      if ( not kernel().node_manager.is_local_node_id( target_id ) )
+        for ( thread drawing_thread = 0; drawing_thread < num_threads; ++drawing_thread )
+        {
+          for ( const auto& drawn_target : drawn_targets[ drawing_thread ][ thread_id ] )
+          {
+            const std::vector< double > source_pos_vector =
+              source_pos_node_id_pairs[ drawn_target.source_index ].first.get_vector();
+            drawn_target.target_pos.get_vector( target_pos_vector );
+
+            const double w = weight_->value( rng, source_pos_vector, target_pos_vector, target );
+            const double d = delay_->value( rng, source_pos_vector, target_pos_vector, target );
+
+            Node* target_ptr = kernel().node_manager.get_node_or_proxy( drawn_target.target_id, thread_id );
+            kernel().connection_manager.connect( source_pos_node_id_pairs[ drawn_target.source_index ].second,
+              target_ptr,
+              thread_id,
+              synapse_model_,
+              dummy_param_dicts_[ thread_id ],
+              d,
+              w );
+          }
+        }
+      }
+      catch ( std::exception& err )
       {
-        continue;
+        // We must create a new exception here, err's lifetime ends at
+        // the end of the catch block.
+        exceptions_raised_.at( thread_id ) =
+          std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
       }
-
-      Node* target_ptr = kernel().node_manager.get_node_or_proxy( target_id );
-      thread target_thread = target_ptr->get_thread();
-      kernel().connection_manager.connect(
-        source_id, target_ptr, target_thread, synapse_model_, dummy_param_dicts_[ target_thread ], d, w );
+    }
+  } // omp parallel
+  // check if any exceptions have been raised
+  for ( thread thr = 0; thr < num_threads; ++thr )
+  {
+    if ( exceptions_raised_.at( thr ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised_.at( thr ) ) );
     }
   }
 }
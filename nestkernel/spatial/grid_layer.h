@@ -130,6 +130,15 @@ public:
 
   Position< D > gridpos_to_position( Position< D, int > gridpos ) const;
 
+  /**
+   * Get grid position of the grid cell containing the given position.
+   * @param pos position in layer coordinates
+   * @param offset set to the position within the cell, in units of the
+   *               grid spacing and in the range [0, 1) for each dimension
+   * @returns grid position, may lie outside the layer.
+   */
+  Position< D, int > position_to_gridpos( const Position< D >& pos, Position< D >& offset ) const;
+
   using Layer< D >::get_global_positions_vector;
 
   std::vector< std::pair< Position< D >, index > > get_global_positions_vector( const AbstractMask& mask,
@@ -237,6 +246,29 @@ GridLayer< D >::gridpos_to_position( Position< D, int > gridpos ) const
   return upper_left + ext / dims_ * gridpos + ext / dims_ * 0.5;
 }
 
+template < int D >
+Position< D, int >
+GridLayer< D >::position_to_gridpos( const Position< D >& pos, Position< D >& offset ) const
+{
+  // grid layer uses "matrix convention", i.e. reversed y axis
+  Position< D > ext = this->extent_;
+  Position< D > upper_left = this->lower_left_;
+  if ( D > 1 )
+  {
+    upper_left[ 1 ] += ext[ 1 ];
+    ext[ 1 ] = -ext[ 1 ];
+  }
+
+  Position< D, int > gridpos;
+  for ( int i = 0; i < D; ++i )
+  {
+    const double x = ( pos[ i ] - upper_left[ i ] ) * dims_[ i ] / ext[ i ];
+    gridpos[ i ] = static_cast< int >( std::floor( x ) );
+    offset[ i ] = x - gridpos[ i ];
+  }
+  return gridpos;
+}
+
 template < int D >
 Position< D >
 GridLayer< D >::get_position( index sind ) const
@@ -44,13 +44,30 @@
 namespace nest
 {
 
-NodeCollectionMetadataPTR AbstractLayer::cached_ntree_md_ = NodeCollectionMetadataPTR( 0 );
-NodeCollectionMetadataPTR AbstractLayer::cached_vector_md_ = NodeCollectionMetadataPTR( 0 );
-
 AbstractLayer::~AbstractLayer()
 {
 }
 
+size_t
+AbstractLayer::new_positions_version_()
+{
+  static size_t next_version = 0;
+  return next_version++;
+}
+
+size_t
+AbstractLayer::get_position_cache_size()
+{
+  return Layer< 2 >::get_position_cache_size_() + Layer< 3 >::get_position_cache_size_();
+}
+
+void
+AbstractLayer::clear_position_caches()
+{
+  Layer< 2 >::clear_position_cache_all_();
+  Layer< 3 >::clear_position_cache_all_();
+}
+
 NodeCollectionPTR
 AbstractLayer::create_layer( const DictionaryDatum& layer_dict )
 {
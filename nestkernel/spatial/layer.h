@@ -26,6 +26,8 @@
 // C++ includes:
 #include <bitset>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <utility>
 
 // Includes from nestkernel:
@@ -37,6 +39,7 @@
 #include "dictutils.h"
 
 // Includes from spatial:
+#include "cell_list.h"
 #include "connection_creator.h"
 #include "ntree.h"
 #include "position.h"
@@ -58,6 +61,16 @@ public:
    */
   AbstractLayer()
     : node_collection_( NodeCollectionPTR( 0 ) )
+    , positions_version_( new_positions_version_() )
+  {
+  }
+
+  /**
+   * Copy constructor. The copy gets its own positions version.
+   */
+  AbstractLayer( const AbstractLayer& other )
+    : node_collection_( other.node_collection_ )
+    , positions_version_( new_positions_version_() )
   {
   }
 
@@ -112,6 +125,23 @@ public:
   virtual double compute_distance( const std::vector< double >& from_pos,
     const std::vector< double >& to_pos ) const = 0;
 
+  /**
+   * Batch versions of compute_displacement and compute_distance for
+   * position vectors. The positions are stored consecutively, a vector
+   * holding a single position is used for all entries of the other.
+   * @param from_pos  positions from which displacements are computed
+   * @param to_pos    positions to which displacements are computed
+   * @param dimension dimension of the displacement
+   * @param result    displacements or distances, one per position
+   */
+  virtual void compute_displacements( const std::vector< double >& from_pos,
+    const std::vector< double >& to_pos,
+    const unsigned int dimension,
+    std::vector< double >& result ) const = 0;
+  virtual void compute_distances( const std::vector< double >& from_pos,
+    const std::vector< double >& to_pos,
+    std::vector< double >& result ) const = 0;
+
   /**
    * Connect this layer to the given target layer. The actual connections
    * are made in class ConnectionCreator.
@@ -134,6 +164,17 @@ public:
    */
   static NodeCollectionPTR create_layer( const DictionaryDatum& );
 
+  /**
+   * Return the number of bytes held by the caches of global position
+   * information of all layers.
+   */
+  static size_t get_position_cache_size();
+
+  /**
+   * Drop cached global position information of all layers.
+   */
+  static void clear_position_caches();
+
   /**
    * Return a vector with the node IDs of the nodes inside the mask.
    * @param mask            mask to apply.
@@ -177,24 +218,16 @@ protected:
   NodeCollectionPTR node_collection_;
 
   /**
-   * Metadata for the layer for which we cache global position information
+   * Version of the positions of this layer. Cached global position
+   * information is tagged with the version it was gathered for, so that
+   * it can no longer be found once the positions change.
    */
-  static NodeCollectionMetadataPTR cached_ntree_md_;
+  size_t positions_version_;
 
   /**
-   * Metadata for the layer for which we cache global position information
+   * Return a fresh positions version, unique over the lifetime of the kernel.
    */
-  static NodeCollectionMetadataPTR cached_vector_md_;
-
-  /**
-   * Clear the cache for global position information
-   */
-  virtual void clear_ntree_cache_() const = 0;
-
-  /**
-   * Clear the cache for global position information
-   */
-  virtual void clear_vector_cache_() const = 0;
+  static size_t new_positions_version_();
 
   /**
    * Gets metadata of the NodeCollection to which this layer belongs.
@@ -332,13 +365,27 @@ public:
 
   double compute_distance( const std::vector< double >& from_pos, const std::vector< double >& to_pos ) const;
 
+  void compute_displacements( const std::vector< double >& from_pos,
+    const std::vector< double >& to_pos,
+    const unsigned int dimension,
+    std::vector< double >& result ) const;
+
+  void compute_distances( const std::vector< double >& from_pos,
+    const std::vector< double >& to_pos,
+    std::vector< double >& result ) const;
+
 
   /**
    * Get positions for all nodes in layer, including nodes on other MPI
    * processes. The positions will be cached so that subsequent calls for
-   * the same layer are fast. One one layer is cached at the time, so the
-   * user should group together all ConnectLayers calls using the same
-   * pool layer.
+   * the same nodes of the layer are fast. The cache holds up to
+   * position_cache_max_entries node sets of layers of this dimension and
+   * is invalidated when the positions of a layer change.
+   *
+   * The cache is shared by all layers of this dimension and is not
+   * protected by a lock, so this function and the other functions
+   * reading global positions must only be called outside of parallel
+   * regions.
    */
   std::shared_ptr< Ntree< D, index > > get_global_positions_ntree( NodeCollectionPTR node_collection );
 
@@ -353,7 +400,14 @@ public:
     Position< D > extent,
     NodeCollectionPTR node_collection );
 
-  std::vector< std::pair< Position< D >, index > >* get_global_positions_vector( NodeCollectionPTR node_collection );
+  /**
+   * Get positions for all nodes in layer, including nodes on other MPI
+   * processes, as a vector of (position, node ID) pairs. The vector is
+   * shared with the position cache and stays valid for as long as the
+   * returned pointer is held, even if the cache entry is dropped. Must
+   * only be called outside of parallel regions.
+   */
+  std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > get_global_positions_vector( NodeCollectionPTR node_collection );
 
   virtual std::vector< std::pair< Position< D >, index > > get_global_positions_vector( const MaskDatum& mask,
     const Position< D >& anchor,
@@ -405,18 +459,60 @@ public:
     AbstractLayerPTR target_layer,
     const Token& syn_model );
 
+  /**
+   * Return the number of bytes held by the position cache for layers of
+   * this dimension.
+   */
+  static size_t get_position_cache_size_();
+
+  /**
+   * Drop all cached global position information for layers of this
+   * dimension.
+   */
+  static void clear_position_cache_all_();
+
 protected:
   /**
-   * Clear the cache for global position information
+   * Global position information for a subset of the nodes in a layer.
+   * The vector and the ntree are created on demand.
+   */
+  struct PositionCacheEntry_
+  {
+    std::shared_ptr< std::vector< std::pair< Position< D >, index > > > vector;
+    std::shared_ptr< Ntree< D, index > > ntree;
+    size_t last_use; //!< value of position_cache_uses_ at the last lookup
+  };
+
+  /**
+   * Key of a cache entry: positions version of the layer, followed by
+   * the node IDs of the NodeCollection in order, encoded as a sequence of
+   * (first node ID, step, number of node IDs) triples, one for each
+   * maximal run of equidistant node IDs. The encoding is exact, so
+   * different NodeCollections never share an entry.
+   */
+  typedef std::pair< size_t, std::vector< index > > PositionCacheKey_;
+
+  /**
+   * Maximum number of entries in the position cache for layers of one
+   * dimension. When a new entry would exceed it, the least recently used
+   * entry is dropped. Must be at least two, since one Connect call may
+   * hold the positions of the source and the target layer at once.
    */
-  void clear_ntree_cache_() const;
+  static const size_t position_cache_max_entries = 16;
 
   /**
-   * Clear the cache for global position information
+   * Return the cache entry for the given nodes of this layer, creating an
+   * empty one if needed. The reference is only valid until the next
+   * lookup. Must only be called outside of parallel regions.
    */
-  void clear_vector_cache_() const;
+  PositionCacheEntry_& get_position_cache_entry_( NodeCollectionPTR node_collection );
 
-  std::shared_ptr< Ntree< D, index > > do_get_global_positions_ntree_( NodeCollectionPTR node_collection );
+  /**
+   * Drop cached global position information of this layer and give the
+   * layer a new positions version. Must be called whenever the positions
+   * or the geometry of the layer change.
+   */
+  void invalidate_position_cache_();
 
   /**
    * Insert global position info into ntree.
@@ -435,10 +531,12 @@ protected:
   std::bitset< D > periodic_; //!< periodic b.c.
 
   /**
-   * Global position information for a single layer
+   * Global position information for all layers of this dimension
    */
-  static std::shared_ptr< Ntree< D, index > > cached_ntree_;
-  static std::vector< std::pair< Position< D >, index > >* cached_vector_;
+  static std::map< PositionCacheKey_, PositionCacheEntry_ > position_cache_;
+
+  //! number of lookups in position_cache_, used to find the least recently used entry
+  static size_t position_cache_uses_;
 
   friend class MaskedLayer< D >;
 };
@@ -458,8 +556,13 @@ public:
    * @param allow_oversized If true, allow larges masks than layers when using
    *                        periodic b.c.
    * @param node_collection NodeCollection of the layer
+   * @param spatial_index   Spatial index used to find the nodes inside the mask
    */
-  MaskedLayer( Layer< D >& layer, const MaskDatum& mask, bool allow_oversized, NodeCollectionPTR node_collection );
+  MaskedLayer( Layer< D >& layer,
+    const MaskDatum& mask,
+    bool allow_oversized,
+    NodeCollectionPTR node_collection,
+    SpatialIndex spatial_index = SpatialIndex::ntree );
 
   /**
    * Constructor for applying "converse" mask to layer. To be used for
@@ -471,12 +574,14 @@ public:
    * @param allow_oversized If true, allow larges masks than layers when using periodic b.c.
    * @param target          The layer which the given mask is defined for (target layer)
    * @param node_collection NodeCollection of the layer
+   * @param spatial_index   Spatial index used to find the nodes inside the mask
    */
   MaskedLayer( Layer< D >& layer,
     const MaskDatum& mask,
     bool allow_oversized,
     Layer< D >& target,
-    NodeCollectionPTR node_collection );
+    NodeCollectionPTR node_collection,
+    SpatialIndex spatial_index = SpatialIndex::ntree );
 
   ~MaskedLayer();
 
@@ -493,6 +598,30 @@ public:
    */
   typename Ntree< D, index >::masked_iterator end();
 
+  /**
+   * @returns true if nodes are found using a CellList instead of an Ntree.
+   */
+  bool uses_cell_list() const;
+
+  /**
+   * Iterate over nodes inside mask using the CellList.
+   * @param anchor Position to apply mask to
+   */
+  typename CellList< D, index >::masked_iterator cell_list_begin( const Position< D >& anchor );
+
+  /**
+   * @return end iterator for the CellList
+   */
+  typename CellList< D, index >::masked_iterator cell_list_end();
+
+  /**
+   * Collect (position, node ID) pairs of all nodes inside mask, using
+   * either spatial index.
+   * @param anchor Position to apply mask to
+   * @param positions Vector to store the pairs in
+   */
+  void get_positions( const Position< D >& anchor, std::vector< std::pair< Position< D >, index > >& positions );
+
 protected:
   /**
    * Will check that the mask can be applied to the layer. The mask must
@@ -506,7 +635,18 @@ protected:
    */
   void check_mask_( Layer< D >& layer, bool allow_oversized );
 
+  /**
+   * Create a CellList instead of an Ntree if selected by spatial_index.
+   * For automatic selection, the mask must be checked already.
+   */
+  void create_cell_list_( Layer< D >& layer,
+    std::bitset< D > periodic,
+    Position< D > extent,
+    NodeCollectionPTR node_collection,
+    SpatialIndex spatial_index );
+
   std::shared_ptr< Ntree< D, index > > ntree_;
+  std::shared_ptr< CellList< D, index > > cell_list_;
   MaskDatum mask_;
 };
 
@@ -514,12 +654,17 @@ template < int D >
 inline MaskedLayer< D >::MaskedLayer( Layer< D >& layer,
   const MaskDatum& maskd,
   bool allow_oversized,
-  NodeCollectionPTR node_collection )
+  NodeCollectionPTR node_collection,
+  SpatialIndex spatial_index )
   : mask_( maskd )
 {
-  ntree_ = layer.get_global_positions_ntree( node_collection );
-
   check_mask_( layer, allow_oversized );
+
+  create_cell_list_( layer, layer.get_periodic_mask(), layer.get_extent(), node_collection, spatial_index );
+  if ( not cell_list_ )
+  {
+    ntree_ = layer.get_global_positions_ntree( node_collection );
+  }
 }
 
 template < int D >
@@ -527,13 +672,19 @@ inline MaskedLayer< D >::MaskedLayer( Layer< D >& layer,
   const MaskDatum& maskd,
   bool allow_oversized,
   Layer< D >& target,
-  NodeCollectionPTR node_collection )
+  NodeCollectionPTR node_collection,
+  SpatialIndex spatial_index )
   : mask_( maskd )
 {
-  ntree_ = layer.get_global_positions_ntree(
-    target.get_periodic_mask(), target.get_lower_left(), target.get_extent(), node_collection );
-
   check_mask_( target, allow_oversized );
+
+  create_cell_list_( layer, target.get_periodic_mask(), target.get_extent(), node_collection, spatial_index );
+  if ( not cell_list_ )
+  {
+    ntree_ = layer.get_global_positions_ntree(
+      target.get_periodic_mask(), target.get_lower_left(), target.get_extent(), node_collection );
+  }
+
   mask_ = new ConverseMask< D >( dynamic_cast< const Mask< D >& >( *mask_ ) );
 }
 
@@ -563,6 +714,27 @@ MaskedLayer< D >::end()
   return ntree_->masked_end();
 }
 
+template < int D >
+inline bool
+MaskedLayer< D >::uses_cell_list() const
+{
+  return cell_list_.get();
+}
+
+template < int D >
+inline typename CellList< D, index >::masked_iterator
+MaskedLayer< D >::cell_list_begin( const Position< D >& anchor )
+{
+  return cell_list_->masked_begin( dynamic_cast< const Mask< D >& >( *mask_ ), anchor );
+}
+
+template < int D >
+inline typename CellList< D, index >::masked_iterator
+MaskedLayer< D >::cell_list_end()
+{
+  return cell_list_->masked_end();
+}
+
 template < int D >
 inline Layer< D >::Layer()
 {
@@ -586,15 +758,7 @@ inline Layer< D >::Layer( const Layer& other_layer )
 template < int D >
 inline Layer< D >::~Layer()
 {
-  if ( cached_ntree_md_ == get_metadata() )
-  {
-    clear_ntree_cache_();
-  }
-
-  if ( cached_vector_md_ == get_metadata() )
-  {
-    clear_vector_cache_();
-  }
+  invalidate_position_cache_();
 }
 
 template < int D >
@@ -653,26 +817,6 @@ Layer< D >::get_position_vector( const index sind ) const
   return get_position( sind ).get_vector();
 }
 
-template < int D >
-inline void
-Layer< D >::clear_ntree_cache_() const
-{
-  cached_ntree_ = std::shared_ptr< Ntree< D, index > >();
-  cached_ntree_md_ = NodeCollectionMetadataPTR( 0 );
-}
-
-template < int D >
-inline void
-Layer< D >::clear_vector_cache_() const
-{
-  if ( cached_vector_ != 0 )
-  {
-    delete cached_vector_;
-  }
-  cached_vector_ = 0;
-  cached_vector_md_ = NodeCollectionMetadataPTR( 0 );
-}
-
 } // namespace nest
 
 #endif
@@ -25,23 +25,33 @@
 
 #include "layer.h"
 
+// C++ includes:
+#include <algorithm>
+#include <cmath>
+
 // Includes from nestkernel:
 #include "node_collection.h"
 #include "nest_datums.h"
 #include "booldatum.h"
 
 // Includes from spatial:
+#include "cell_list_impl.h"
 #include "grid_layer.h"
 #include "grid_mask.h"
 
+#ifdef _OPENMP
+// C includes:
+#include <omp.h>
+#endif
+
 namespace nest
 {
 
 template < int D >
-std::shared_ptr< Ntree< D, index > > Layer< D >::cached_ntree_;
+std::map< typename Layer< D >::PositionCacheKey_, typename Layer< D >::PositionCacheEntry_ > Layer< D >::position_cache_;
 
 template < int D >
-std::vector< std::pair< Position< D >, index > >* Layer< D >::cached_vector_ = 0;
+size_t Layer< D >::position_cache_uses_ = 0;
 
 template < int D >
 Position< D >
@@ -77,10 +87,74 @@ Layer< D >::compute_displacement( const std::vector< double >& from_pos,
   return displacement;
 }
 
+template < int D >
+void
+Layer< D >::compute_displacements( const std::vector< double >& from_pos,
+  const std::vector< double >& to_pos,
+  const unsigned int dimension,
+  std::vector< double >& result ) const
+{
+  const size_t num_positions = std::max( from_pos.size(), to_pos.size() ) / D;
+  const size_t from_stride = from_pos.size() == D ? 0 : D;
+  const size_t to_stride = to_pos.size() == D ? 0 : D;
+  const double* from = from_pos.data() + dimension;
+  const double* to = to_pos.data() + dimension;
+
+  result.resize( num_positions );
+  for ( size_t k = 0; k < num_positions; ++k )
+  {
+    result[ k ] = to[ k * to_stride ] - from[ k * from_stride ];
+  }
+  if ( periodic_[ dimension ] )
+  {
+    const double extent = extent_[ dimension ];
+    const double inverse_extent = 1 / extent;
+    for ( size_t k = 0; k < num_positions; ++k )
+    {
+      result[ k ] -= extent * std::round( result[ k ] * inverse_extent );
+    }
+  }
+}
+
+template < int D >
+void
+Layer< D >::compute_distances( const std::vector< double >& from_pos,
+  const std::vector< double >& to_pos,
+  std::vector< double >& result ) const
+{
+  const size_t num_positions = std::max( from_pos.size(), to_pos.size() ) / D;
+  const size_t from_stride = from_pos.size() == D ? 0 : D;
+  const size_t to_stride = to_pos.size() == D ? 0 : D;
+
+  // One pass per dimension keeps the inner loops free of branches, and
+  // adds the squared displacements in the same order as compute_distance.
+  result.assign( num_positions, 0.0 );
+  for ( int i = 0; i < D; ++i )
+  {
+    const double* from = from_pos.data() + i;
+    const double* to = to_pos.data() + i;
+    const double extent = periodic_[ i ] ? extent_[ i ] : 0.0;
+    const double inverse_extent = periodic_[ i ] ? 1 / extent_[ i ] : 0.0;
+    for ( size_t k = 0; k < num_positions; ++k )
+    {
+      double displacement = to[ k * to_stride ] - from[ k * from_stride ];
+      displacement -= extent * std::round( displacement * inverse_extent );
+      result[ k ] += displacement * displacement;
+    }
+  }
+  for ( size_t k = 0; k < num_positions; ++k )
+  {
+    result[ k ] = std::sqrt( result[ k ] );
+  }
+}
+
 template < int D >
 void
 Layer< D >::set_status( const DictionaryDatum& d )
 {
+  // Positions and geometry may change, so cached positions are stale
+  invalidate_position_cache_();
+
   if ( d->known( names::edge_wrap ) )
   {
     if ( getValue< bool >( d, names::edge_wrap ) )
@@ -131,119 +205,185 @@ Layer< D >::connect( NodeCollectionPTR source_nc,
 }
 
 template < int D >
-std::shared_ptr< Ntree< D, index > >
-Layer< D >::get_global_positions_ntree( NodeCollectionPTR node_collection )
+typename Layer< D >::PositionCacheEntry_&
+Layer< D >::get_position_cache_entry_( NodeCollectionPTR node_collection )
 {
-  if ( cached_ntree_md_ == node_collection->get_metadata() )
+#ifdef _OPENMP
+  // the cache is static and shared by all layers of this dimension
+  assert( not omp_in_parallel() );
+#endif
+
+  PositionCacheKey_ key( positions_version_, std::vector< index >() );
+  std::vector< index >& runs = key.second;
+  for ( NodeCollection::const_iterator it = node_collection->begin(); it < node_collection->end(); ++it )
   {
-    assert( cached_ntree_.get() );
-    return cached_ntree_;
+    const index node_id = ( *it ).node_id;
+    const size_t n_runs = runs.size() / 3;
+    if ( n_runs > 0 )
+    {
+      index& first = runs[ 3 * n_runs - 3 ];
+      index& step = runs[ 3 * n_runs - 2 ];
+      index& count = runs[ 3 * n_runs - 1 ];
+      if ( count == 1 and node_id > first )
+      {
+        step = node_id - first;
+        ++count;
+        continue;
+      }
+      if ( count > 1 and node_id == first + count * step )
+      {
+        ++count;
+        continue;
+      }
+    }
+    runs.push_back( node_id );
+    runs.push_back( 0 );
+    runs.push_back( 1 );
   }
 
-  clear_ntree_cache_();
-
-  cached_ntree_ =
-    std::shared_ptr< Ntree< D, index > >( new Ntree< D, index >( this->lower_left_, this->extent_, this->periodic_ ) );
+  typename std::map< PositionCacheKey_, PositionCacheEntry_ >::iterator entry = position_cache_.find( key );
+  if ( entry == position_cache_.end() )
+  {
+    if ( position_cache_.size() >= position_cache_max_entries )
+    {
+      typename std::map< PositionCacheKey_, PositionCacheEntry_ >::iterator oldest = position_cache_.begin();
+      for ( entry = position_cache_.begin(); entry != position_cache_.end(); ++entry )
+      {
+        if ( entry->second.last_use < oldest->second.last_use )
+        {
+          oldest = entry;
+        }
+      }
+      position_cache_.erase( oldest );
+    }
+    entry = position_cache_.insert( std::make_pair( key, PositionCacheEntry_() ) ).first;
+  }
 
-  return do_get_global_positions_ntree_( node_collection );
+  entry->second.last_use = position_cache_uses_++;
+  return entry->second;
 }
 
 template < int D >
-std::shared_ptr< Ntree< D, index > >
-Layer< D >::get_global_positions_ntree( std::bitset< D > periodic,
-  Position< D > lower_left,
-  Position< D > extent,
-  NodeCollectionPTR node_collection )
+void
+Layer< D >::invalidate_position_cache_()
 {
-  clear_ntree_cache_();
-  clear_vector_cache_();
+  position_cache_.erase( position_cache_.lower_bound( PositionCacheKey_( positions_version_, std::vector< index >() ) ),
+    position_cache_.lower_bound( PositionCacheKey_( positions_version_ + 1, std::vector< index >() ) ) );
 
-  // Keep layer geometry for non-periodic dimensions
-  for ( int i = 0; i < D; ++i )
+  positions_version_ = new_positions_version_();
+}
+
+template < int D >
+size_t
+Layer< D >::get_position_cache_size_()
+{
+  size_t size = 0;
+  for ( auto& entry : position_cache_ )
   {
-    if ( not periodic[ i ] )
+    if ( entry.second.vector )
     {
-      extent[ i ] = extent_[ i ];
-      lower_left[ i ] = lower_left_[ i ];
+      size += sizeof( *entry.second.vector ) + entry.second.vector->capacity() * sizeof( std::pair< Position< D >, index > );
+    }
+    if ( entry.second.ntree )
+    {
+      size += entry.second.ntree->get_memory_size();
     }
   }
+  return size;
+}
 
-  cached_ntree_ = std::shared_ptr< Ntree< D, index > >( new Ntree< D, index >( this->lower_left_, extent, periodic ) );
-
-  do_get_global_positions_ntree_( node_collection );
-
-  // Do not use cache since the periodic bits and extents were altered.
-  cached_ntree_md_ = NodeCollectionMetadataPTR( 0 );
-
-  return cached_ntree_;
+template < int D >
+void
+Layer< D >::clear_position_cache_all_()
+{
+  position_cache_.clear();
 }
 
 template < int D >
 std::shared_ptr< Ntree< D, index > >
-Layer< D >::do_get_global_positions_ntree_( NodeCollectionPTR node_collection )
+Layer< D >::get_global_positions_ntree( NodeCollectionPTR node_collection )
 {
-  if ( cached_vector_md_ == node_collection->get_metadata() )
+  PositionCacheEntry_& entry = get_position_cache_entry_( node_collection );
+  if ( entry.ntree )
   {
-    // Convert from vector to Ntree
+    return entry.ntree;
+  }
 
-    typename std::insert_iterator< Ntree< D, index > > to = std::inserter( *cached_ntree_, cached_ntree_->end() );
+  entry.ntree =
+    std::shared_ptr< Ntree< D, index > >( new Ntree< D, index >( this->lower_left_, this->extent_, this->periodic_ ) );
 
-    for ( typename std::vector< std::pair< Position< D >, index > >::iterator from = cached_vector_->begin();
-          from != cached_vector_->end();
-          ++from )
+  if ( entry.vector )
+  {
+    // Convert from vector to Ntree, avoiding communication
+    for ( auto& node : *entry.vector )
     {
-      *to = *from;
+      entry.ntree->insert( node );
     }
   }
   else
   {
+    insert_global_positions_ntree_( *entry.ntree, node_collection );
+  }
+
+  return entry.ntree;
+}
 
-    insert_global_positions_ntree_( *cached_ntree_, node_collection );
+template < int D >
+std::shared_ptr< Ntree< D, index > >
+Layer< D >::get_global_positions_ntree( std::bitset< D > periodic,
+  Position< D > lower_left,
+  Position< D > extent,
+  NodeCollectionPTR node_collection )
+{
+  // Keep layer geometry for non-periodic dimensions
+  for ( int i = 0; i < D; ++i )
+  {
+    if ( not periodic[ i ] )
+    {
+      extent[ i ] = extent_[ i ];
+      lower_left[ i ] = lower_left_[ i ];
+    }
   }
 
-  clear_vector_cache_();
+  // The ntree itself is not cached since the periodic bits and extents
+  // were altered, but the gathered positions are.
+  std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > positions = get_global_positions_vector( node_collection );
 
-  cached_ntree_md_ = node_collection->get_metadata();
+  std::shared_ptr< Ntree< D, index > > ntree( new Ntree< D, index >( this->lower_left_, extent, periodic ) );
+  for ( const auto& node : *positions )
+  {
+    ntree->insert( node );
+  }
 
-  return cached_ntree_;
+  return ntree;
 }
 
 template < int D >
-std::vector< std::pair< Position< D >, index > >*
+std::shared_ptr< const std::vector< std::pair< Position< D >, index > > >
 Layer< D >::get_global_positions_vector( NodeCollectionPTR node_collection )
 {
-  if ( cached_vector_md_ == node_collection->get_metadata() )
+  PositionCacheEntry_& entry = get_position_cache_entry_( node_collection );
+  if ( entry.vector )
   {
-    assert( cached_vector_ );
-    return cached_vector_;
+    return entry.vector;
   }
 
-  clear_vector_cache_();
+  entry.vector = std::make_shared< std::vector< std::pair< Position< D >, index > > >();
 
-  cached_vector_ = new std::vector< std::pair< Position< D >, index > >;
-
-  if ( cached_ntree_md_ == node_collection->get_metadata() )
+  if ( entry.ntree )
   {
-    // Convert from NTree to vector
-
-    typename std::back_insert_iterator< std::vector< std::pair< Position< D >, index > > > to =
-      std::back_inserter( *cached_vector_ );
-
-    for ( typename Ntree< D, index >::iterator from = cached_ntree_->begin(); from != cached_ntree_->end(); ++from )
+    // Convert from Ntree to vector, avoiding communication
+    for ( typename Ntree< D, index >::iterator from = entry.ntree->begin(); from != entry.ntree->end(); ++from )
     {
-      *to = *from;
+      entry.vector->push_back( *from );
     }
   }
   else
   {
-    insert_global_positions_vector_( *cached_vector_, node_collection );
+    insert_global_positions_vector_( *entry.vector, node_collection );
   }
 
-  clear_ntree_cache_();
-
-  cached_vector_md_ = node_collection->get_metadata();
-
-  return cached_vector_;
+  return entry.vector;
 }
 
 template < int D >
@@ -302,7 +442,7 @@ Layer< D >::dump_connections( std::ostream& out,
   AbstractLayerPTR target_layer,
   const Token& syn_model )
 {
-  std::vector< std::pair< Position< D >, index > >* src_vec = get_global_positions_vector( node_collection );
+  std::shared_ptr< const std::vector< std::pair< Position< D >, index > > > src_vec = get_global_positions_vector( node_collection );
 
   // Dictionary with parameters for get_connections()
   DictionaryDatum ncdict( new Dictionary );
@@ -311,7 +451,7 @@ Layer< D >::dump_connections( std::ostream& out,
   // Avoid setting up new array for each iteration of the loop
   std::vector< index > source_array( 1 );
 
-  for ( typename std::vector< std::pair< Position< D >, index > >::iterator src_iter = src_vec->begin();
+  for ( typename std::vector< std::pair< Position< D >, index > >::const_iterator src_iter = src_vec->begin();
         src_iter != src_vec->end();
         ++src_iter )
   {
@@ -433,6 +573,60 @@ MaskedLayer< D >::check_mask_( Layer< D >& layer, bool allow_oversized )
   }
 }
 
+template < int D >
+void
+MaskedLayer< D >::create_cell_list_( Layer< D >& layer,
+  std::bitset< D > periodic,
+  Position< D > extent,
+  NodeCollectionPTR node_collection,
+  SpatialIndex spatial_index )
+{
+  if ( spatial_index == SpatialIndex::ntree )
+  {
+    return;
+  }
+
+  if ( spatial_index == SpatialIndex::automatic
+    and not CellList< D, index >::is_suitable(
+          node_collection->size(), layer.get_extent(), dynamic_cast< const Mask< D >& >( *mask_ ) ) )
+  {
+    return;
+  }
+
+  // Keep layer geometry for non-periodic dimensions, as for the Ntree
+  for ( int i = 0; i < D; ++i )
+  {
+    if ( not periodic[ i ] )
+    {
+      extent[ i ] = layer.get_extent()[ i ];
+    }
+  }
+
+  cell_list_ = std::shared_ptr< CellList< D, index > >( new CellList< D, index >(
+    layer.get_lower_left(), extent, periodic, *layer.get_global_positions_vector( node_collection ) ) );
+
+  if ( spatial_index == SpatialIndex::automatic and not cell_list_->is_uniform() )
+  {
+    cell_list_.reset();
+  }
+}
+
+template < int D >
+void
+MaskedLayer< D >::get_positions( const Position< D >& anchor,
+  std::vector< std::pair< Position< D >, index > >& positions )
+{
+  positions.clear();
+  if ( cell_list_ )
+  {
+    std::copy( cell_list_begin( anchor ), cell_list_end(), std::back_inserter( positions ) );
+  }
+  else
+  {
+    std::copy( begin( anchor ), end(), std::back_inserter( positions ) );
+  }
+}
+
 } // namespace nest
 
 #endif
@@ -368,6 +368,39 @@ EllipseMask< 3 >::inside( const Position< 3 >& p ) const
   return std::pow( new_x, 2 ) * x_scale_ + std::pow( new_y, 2 ) * y_scale_ + std::pow( new_z, 2 ) * z_scale_ <= 1;
 }
 
+template <>
+void
+EllipseMask< 2 >::inside( const Position< 2 >* points, const size_t n, bool* result ) const
+{
+  for ( size_t k = 0; k < n; ++k )
+  {
+    const double dx = points[ k ][ 0 ] - center_[ 0 ];
+    const double dy = points[ k ][ 1 ] - center_[ 1 ];
+    const double new_x = dx * azimuth_cos_ + dy * azimuth_sin_;
+    const double new_y = dx * azimuth_sin_ - dy * azimuth_cos_;
+
+    result[ k ] = new_x * new_x * x_scale_ + new_y * new_y * y_scale_ <= 1;
+  }
+}
+
+template <>
+void
+EllipseMask< 3 >::inside( const Position< 3 >* points, const size_t n, bool* result ) const
+{
+  // Same rotation as in inside( const Position< 3 >& )
+  for ( size_t k = 0; k < n; ++k )
+  {
+    const double dx = points[ k ][ 0 ] - center_[ 0 ];
+    const double dy = points[ k ][ 1 ] - center_[ 1 ];
+    const double dz = points[ k ][ 2 ] - center_[ 2 ];
+    const double new_x = ( dx * azimuth_cos_ + dy * azimuth_sin_ ) * polar_cos_ - dz * polar_sin_;
+    const double new_y = dx * azimuth_sin_ - dy * azimuth_cos_;
+    const double new_z = ( dx * azimuth_cos_ + dy * azimuth_sin_ ) * polar_sin_ + dz * polar_cos_;
+
+    result[ k ] = new_x * new_x * x_scale_ + new_y * new_y * y_scale_ + new_z * new_z * z_scale_ <= 1;
+  }
+}
+
 template <>
 bool
 EllipseMask< 2 >::inside( const Box< 2 >& b ) const
@@ -104,6 +104,12 @@ class Mask : public AbstractMask
 public:
   using AbstractMask::inside;
 
+  /**
+   * Number of points transformed at once on the stack by masks that
+   * check a batch of points through another mask.
+   */
+  static const size_t mask_batch_size = 32;
+
   ~Mask()
   {
   }
@@ -125,6 +131,15 @@ public:
    */
   virtual bool inside( const Box< D >& ) const = 0;
 
+  /**
+   * Check a batch of points. Masks with a simple geometry override this
+   * with a loop the compiler can vectorize.
+   * @param points array of n positions
+   * @param n      number of positions
+   * @param result array of n flags, set to true for points inside the mask
+   */
+  virtual void inside( const Position< D >* points, const size_t n, bool* result ) const;
+
   /**
    * @returns true if the whole box is outside the mask.
    * @note a return value of false is not a guarantee that the whole box
@@ -241,6 +256,8 @@ public:
    */
   bool inside( const Box< D >& b ) const;
 
+  void inside( const Position< D >* points, const size_t n, bool* result ) const;
+
   /**
    * @returns true if the whole given box is outside this box
    */
@@ -342,6 +359,8 @@ public:
    */
   bool inside( const Box< D >& ) const;
 
+  void inside( const Position< D >* points, const size_t n, bool* result ) const;
+
   /**
    * @returns true if the whole box is outside the circle
    */
@@ -447,6 +466,8 @@ public:
    */
   bool inside( const Box< D >& ) const;
 
+  void inside( const Position< D >* points, const size_t n, bool* result ) const;
+
   /**
    * @returns true if the whole box is outside the ellipse
    */
@@ -669,6 +690,8 @@ public:
 
   bool inside( const Box< D >& b ) const;
 
+  void inside( const Position< D >* points, const size_t n, bool* result ) const;
+
   bool outside( const Box< D >& b ) const;
 
   Box< D > get_bbox() const;
@@ -718,6 +741,8 @@ public:
 
   bool inside( const Box< D >& b ) const;
 
+  void inside( const Position< D >* points, const size_t n, bool* result ) const;
+
   bool outside( const Box< D >& b ) const;
 
   Box< D > get_bbox() const;
@@ -25,6 +25,10 @@
 
 #include "mask.h"
 
+// C++ includes:
+#include <cmath>
+#include <vector>
+
 namespace nest
 {
 
@@ -71,6 +75,16 @@ Mask< D >::inside( const std::vector< double >& pt ) const
   return inside( Position< D >( pt ) );
 }
 
+template < int D >
+void
+Mask< D >::inside( const Position< D >* points, const size_t n, bool* result ) const
+{
+  for ( size_t k = 0; k < n; ++k )
+  {
+    result[ k ] = inside( points[ k ] );
+  }
+}
+
 template < int D >
 bool
 Mask< D >::outside( const Box< D >& b ) const
@@ -93,6 +107,28 @@ BoxMask< D >::inside( const Box< D >& b ) const
   return ( inside( b.lower_left ) and inside( b.upper_right ) );
 }
 
+template < int D >
+void
+BoxMask< D >::inside( const Position< D >* points, const size_t n, bool* result ) const
+{
+  if ( is_rotated_ )
+  {
+    Mask< D >::inside( points, n, result );
+    return;
+  }
+
+  // Same comparisons as Position::operator<=, without early exit
+  for ( size_t k = 0; k < n; ++k )
+  {
+    bool is_inside = true;
+    for ( int i = 0; i < D; ++i )
+    {
+      is_inside &= not( lower_left_[ i ] > points[ k ][ i ] ) & not( points[ k ][ i ] > upper_right_[ i ] );
+    }
+    result[ k ] = is_inside;
+  }
+}
+
 template < int D >
 bool
 BoxMask< D >::outside( const Box< D >& b ) const
@@ -167,6 +203,28 @@ BallMask< D >::inside( const Position< D >& p ) const
   return ( p - center_ ).length() <= radius_;
 }
 
+template < int D >
+void
+BallMask< D >::inside( const Position< D >* points, const size_t n, bool* result ) const
+{
+  // Evaluates all the tests of inside( Position ) for every point, which
+  // avoids branches and gives the same result.
+  for ( size_t k = 0; k < n; ++k )
+  {
+    bool in_box = true;
+    double dim_sum = 0;
+    double squared_length = 0;
+    for ( int i = 0; i < D; ++i )
+    {
+      const double di = points[ k ][ i ] - center_[ i ];
+      in_box &= not( std::abs( di ) > radius_ );
+      dim_sum += std::abs( di );
+      squared_length += di * di;
+    }
+    result[ k ] = in_box & ( ( dim_sum <= radius_ ) | ( std::sqrt( squared_length ) <= radius_ ) );
+  }
+}
+
 template < int D >
 bool
 BallMask< D >::outside( const Box< D >& b ) const
@@ -443,6 +501,22 @@ ConverseMask< D >::inside( const Box< D >& b ) const
   return m_->inside( Box< D >( -b.upper_right, -b.lower_left ) );
 }
 
+template < int D >
+void
+ConverseMask< D >::inside( const Position< D >* points, const size_t n, bool* result ) const
+{
+  Position< D > mirrored[ Mask< D >::mask_batch_size ];
+  for ( size_t begin = 0; begin < n; begin += Mask< D >::mask_batch_size )
+  {
+    const size_t batch_size = n - begin < Mask< D >::mask_batch_size ? n - begin : Mask< D >::mask_batch_size;
+    for ( size_t k = 0; k < batch_size; ++k )
+    {
+      mirrored[ k ] = -points[ begin + k ];
+    }
+    m_->inside( mirrored, batch_size, result + begin );
+  }
+}
+
 template < int D >
 bool
 ConverseMask< D >::outside( const Box< D >& b ) const
@@ -479,6 +553,22 @@ AnchoredMask< D >::inside( const Box< D >& b ) const
   return m_->inside( Box< D >( b.lower_left - anchor_, b.upper_right - anchor_ ) );
 }
 
+template < int D >
+void
+AnchoredMask< D >::inside( const Position< D >* points, const size_t n, bool* result ) const
+{
+  Position< D > shifted[ Mask< D >::mask_batch_size ];
+  for ( size_t begin = 0; begin < n; begin += Mask< D >::mask_batch_size )
+  {
+    const size_t batch_size = n - begin < Mask< D >::mask_batch_size ? n - begin : Mask< D >::mask_batch_size;
+    for ( size_t k = 0; k < batch_size; ++k )
+    {
+      shifted[ k ] = points[ begin + k ] - anchor_;
+    }
+    m_->inside( shifted, batch_size, result + begin );
+  }
+}
+
 template < int D >
 bool
 AnchoredMask< D >::outside( const Box< D >& b ) const
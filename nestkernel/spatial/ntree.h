@@ -55,6 +55,11 @@ class Ntree
 public:
   static const int N = 1 << D;
 
+  /**
+   * Number of nodes of a leaf checked against the mask in one batch.
+   */
+  static const size_t mask_batch_size = 32;
+
   typedef Position< D > key_type;
   typedef T mapped_type;
   typedef std::pair< Position< D >, T > value_type;
@@ -160,6 +165,9 @@ public:
       , allin_top_( 0 )
       , node_( 0 )
       , mask_( 0 )
+      , batch_ntree_( 0 )
+      , batch_begin_( 0 )
+      , batch_end_( 0 )
     {
     }
 
@@ -236,15 +244,22 @@ public:
      */
     void next_anchor_();
 
+    /**
+     * Check if the current node is inside the mask. The nodes of a leaf
+     * are checked in batches, starting at the current node.
+     */
     bool
-    anchored_position_inside_mask( const Position< D >& position )
+    node_inside_mask_()
     {
-      // Create anchored position in two steps to avoid creating a new Position object.
-      anchored_position_ = position;
-      anchored_position_ -= anchor_;
-      return mask_->inside( anchored_position_ );
+      if ( ntree_ != batch_ntree_ or node_ < batch_begin_ or node_ >= batch_end_ )
+      {
+        check_batch_();
+      }
+      return inside_[ node_ - batch_begin_ ];
     }
 
+    void check_batch_();
+
     Ntree* ntree_;
     Ntree* top_;
     Ntree* allin_top_;
@@ -254,6 +269,10 @@ public:
     Position< D > anchored_position_;
     std::vector< Position< D > > anchors_;
     index current_anchor_;
+    Ntree* batch_ntree_;             //!< leaf of the checked batch
+    index batch_begin_;              //!< first node of the checked batch
+    index batch_end_;                //!< end of the checked batch
+    bool inside_[ mask_batch_size ]; //!< mask results for the checked batch
   };
 
   /**
@@ -342,6 +361,11 @@ public:
    */
   bool is_leaf() const;
 
+  /**
+   * @returns number of bytes allocated by this ntree and its subtrees.
+   */
+  size_t get_memory_size() const;
+
 protected:
   /**
    * Change a leaf ntree to a regular ntree with four
@@ -435,6 +459,21 @@ Ntree< D, T, max_capacity, max_depth >::is_leaf() const
 }
 
 
+template < int D, class T, int max_capacity, int max_depth >
+size_t
+Ntree< D, T, max_capacity, max_depth >::get_memory_size() const
+{
+  size_t size = sizeof( *this ) + nodes_.capacity() * sizeof( value_type );
+  if ( not leaf_ )
+  {
+    for ( size_t n = 0; n < static_cast< size_t >( N ); ++n )
+    {
+      size += children_[ n ]->get_memory_size();
+    }
+  }
+  return size;
+}
+
 template < int D, class T, int max_capacity, int max_depth >
 std::vector< std::pair< Position< D >, T > >
 Ntree< D, T, max_capacity, max_depth >::get_nodes()
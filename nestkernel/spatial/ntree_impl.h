@@ -25,6 +25,10 @@
 
 #include "ntree.h"
 
+// C++ includes:
+#include <algorithm>
+#include <memory>
+
 // Includes from spatial:
 #include "mask.h"
 
@@ -130,6 +134,9 @@ Ntree< D, T, max_capacity, max_depth >::masked_iterator::masked_iterator( Ntree<
   , anchor_( anchor )
   , anchors_()
   , current_anchor_( 0 )
+  , batch_ntree_( 0 )
+  , batch_begin_( 0 )
+  , batch_end_( 0 )
 {
   if ( ntree_->periodic_.any() )
   {
@@ -182,6 +189,8 @@ Ntree< D, T, max_capacity, max_depth >::masked_iterator::init_()
   node_ = 0;
   allin_top_ = 0;
   ntree_ = top_;
+  // Batches checked for a previous anchor are invalid
+  batch_ntree_ = 0;
 
   if ( mask_->outside( Box< D >( ntree_->lower_left_ - anchor_, ntree_->lower_left_ - anchor_ + ntree_->extent_ ) ) )
   {
@@ -345,6 +354,24 @@ Ntree< D, T, max_capacity, max_depth >::masked_iterator::first_leaf_inside_()
   }
 }
 
+template < int D, class T, int max_capacity, int max_depth >
+void
+Ntree< D, T, max_capacity, max_depth >::masked_iterator::check_batch_()
+{
+  batch_ntree_ = ntree_;
+  batch_begin_ = node_;
+  batch_end_ = std::min( node_ + mask_batch_size, ntree_->nodes_.size() );
+
+  Position< D > anchored_positions[ mask_batch_size ];
+  const size_t batch_size = batch_end_ - batch_begin_;
+  for ( size_t k = 0; k < batch_size; ++k )
+  {
+    anchored_positions[ k ] = ntree_->nodes_[ batch_begin_ + k ].first;
+    anchored_positions[ k ] -= anchor_;
+  }
+  mask_->inside( anchored_positions, batch_size, inside_ );
+}
+
 template < int D, class T, int max_capacity, int max_depth >
 typename Ntree< D, T, max_capacity, max_depth >::masked_iterator&
   Ntree< D, T, max_capacity, max_depth >::masked_iterator::
@@ -354,8 +381,7 @@ typename Ntree< D, T, max_capacity, max_depth >::masked_iterator&
 
   if ( allin_top_ == 0 )
   {
-    while (
-      ( node_ < ntree_->nodes_.size() ) && ( not anchored_position_inside_mask( ntree_->nodes_[ node_ ].first ) ) )
+    while ( ( node_ < ntree_->nodes_.size() ) && ( not node_inside_mask_() ) )
     {
       ++node_;
     }
@@ -373,8 +399,7 @@ typename Ntree< D, T, max_capacity, max_depth >::masked_iterator&
 
     if ( allin_top_ == 0 )
     {
-      while (
-        ( node_ < ntree_->nodes_.size() ) && ( not anchored_position_inside_mask( ntree_->nodes_[ node_ ].first ) ) )
+      while ( ( node_ < ntree_->nodes_.size() ) && ( not node_inside_mask_() ) )
       {
         ++node_;
       }
@@ -430,12 +455,20 @@ Ntree< D, T, max_capacity, max_depth >::append_nodes_( std::vector< std::pair< P
   }
   if ( leaf_ )
   {
+    const size_t num_nodes = nodes_.size();
+    std::vector< Position< D > > anchored_positions( num_nodes );
+    for ( size_t i = 0; i < num_nodes; ++i )
+    {
+      anchored_positions[ i ] = nodes_[ i ].first - anchor;
+    }
+    std::unique_ptr< bool[] > is_inside( new bool[ num_nodes ] );
+    mask.inside( anchored_positions.data(), num_nodes, is_inside.get() );
 
-    for ( typename std::vector< std::pair< Position< D >, T > >::iterator i = nodes_.begin(); i != nodes_.end(); ++i )
+    for ( size_t i = 0; i < num_nodes; ++i )
     {
-      if ( mask.inside( i->first - anchor ) )
+      if ( is_inside[ i ] )
       {
-        v.push_back( *i );
+        v.push_back( nodes_[ i ] );
       }
     }
   }
@@ -45,6 +45,10 @@ enum enum_status_spike_data_id
  * Used to communicate spikes. These are the elements of the MPI
  * buffers.
  *
+ * Spikes from neurons with precise spike times are flagged as off-grid.
+ * Their offsets are communicated separately in the order of the flagged
+ * entries, so that spikes from grid-based neurons do not carry an offset.
+ *
  * @see TargetData
  */
 class SpikeData
@@ -54,6 +58,7 @@ protected:
 
   index lcid_ : NUM_BITS_LCID;                       //!< local connection index
   unsigned int marker_ : NUM_BITS_MARKER_SPIKE_DATA; //!< status flag
+  bool off_grid_ : NUM_BITS_OFF_GRID_FLAG;           //!< whether an offset is sent for this spike
   unsigned int lag_ : NUM_BITS_LAG;                  //!< lag in this min-delay interval
   unsigned int tid_ : NUM_BITS_TID;                  //!< thread index
   synindex syn_id_ : NUM_BITS_SYN_ID;                //!< synapse-type index
@@ -121,9 +126,14 @@ public:
   bool is_invalid_marker() const;
 
   /**
-   * Returns offset.
+   * Flags spike as off-grid, i.e., an offset is sent for this spike.
+   */
+  void set_off_grid();
+
+  /**
+   * Returns whether an offset is sent for this spike.
    */
-  double get_offset() const;
+  bool is_off_grid() const;
 };
 
 //! check legal size
@@ -132,6 +142,7 @@ using success_spike_data_size = StaticAssert< sizeof( SpikeData ) == 8 >::succes
 inline SpikeData::SpikeData()
   : lcid_( 0 )
   , marker_( SPIKE_DATA_ID_DEFAULT )
+  , off_grid_( false )
   , lag_( 0 )
   , tid_( 0 )
   , syn_id_( 0 )
@@ -141,6 +152,7 @@ inline SpikeData::SpikeData()
 inline SpikeData::SpikeData( const SpikeData& rhs )
   : lcid_( rhs.lcid_ )
   , marker_( SPIKE_DATA_ID_DEFAULT )
+  , off_grid_( rhs.off_grid_ )
   , lag_( rhs.lag_ )
   , tid_( rhs.tid_ )
   , syn_id_( rhs.syn_id_ )
@@ -150,6 +162,7 @@ inline SpikeData::SpikeData( const SpikeData& rhs )
 inline SpikeData::SpikeData( const thread tid, const synindex syn_id, const index lcid, const unsigned int lag )
   : lcid_( lcid )
   , marker_( SPIKE_DATA_ID_DEFAULT )
+  , off_grid_( false )
   , lag_( lag )
   , tid_( tid )
   , syn_id_( syn_id )
@@ -170,6 +183,7 @@ SpikeData::set( const thread tid, const synindex syn_id, const index lcid, const
   lag_ = lag;
   tid_ = tid;
   syn_id_ = syn_id;
+  off_grid_ = false;
 }
 
 inline index
@@ -238,71 +252,16 @@ SpikeData::is_invalid_marker() const
   return marker_ == SPIKE_DATA_ID_INVALID;
 }
 
-inline double
-SpikeData::get_offset() const
-{
-  return 0;
-}
-
-class OffGridSpikeData : public SpikeData
-{
-private:
-  double offset_;
-
-public:
-  OffGridSpikeData();
-  OffGridSpikeData( const thread tid,
-    const synindex syn_id,
-    const index lcid,
-    const unsigned int lag,
-    const double offset );
-  void set( const thread tid, const synindex syn_id, const index lcid, const unsigned int lag, const double offset );
-  double get_offset() const;
-};
-
-//! check legal size
-using success_offgrid_spike_data_size = StaticAssert< sizeof( OffGridSpikeData ) == 16 >::success;
-
-inline OffGridSpikeData::OffGridSpikeData()
-  : SpikeData()
-  , offset_( 0. )
-{
-}
-
-inline OffGridSpikeData::OffGridSpikeData( const thread tid,
-  const synindex syn_id,
-  const index lcid,
-  const unsigned int lag,
-  const double offset )
-  : SpikeData( tid, syn_id, lcid, lag )
-  , offset_( offset )
-{
-}
-
 inline void
-OffGridSpikeData::set( const thread tid,
-  const synindex syn_id,
-  const index lcid,
-  const unsigned int lag,
-  const double offset )
+SpikeData::set_off_grid()
 {
-  assert( tid <= MAX_TID );
-  assert( syn_id <= MAX_SYN_ID );
-  assert( lcid <= MAX_LCID );
-  assert( lag < MAX_LAG );
-
-  lcid_ = lcid;
-  marker_ = SPIKE_DATA_ID_DEFAULT;
-  lag_ = lag;
-  tid_ = tid;
-  syn_id_ = syn_id;
-  offset_ = offset;
+  off_grid_ = true;
 }
 
-inline double
-OffGridSpikeData::get_offset() const
+inline bool
+SpikeData::is_off_grid() const
 {
-  return offset_;
+  return off_grid_;
 }
 
 } // namespace nest
@@ -144,7 +144,11 @@ nest::SynapticElement::set( const DictionaryDatum& d )
 * Update the number of element at the time t (in ms)
 * ---------------------------------------------------------------- */
 void
-nest::SynapticElement::update( double t, double t_minus, double Ca_minus, double tau_Ca )
+nest::SynapticElement::update( double t,
+  double t_minus,
+  double Ca_minus,
+  double tau_Ca,
+  const std::vector< double >& Ca_trace )
 {
   if ( z_t_ != t_minus )
   {
@@ -152,6 +156,6 @@ nest::SynapticElement::update( double t, double t_minus, double Ca_minus, double
       "Last update of the calcium concentration does not match the last update "
       "of the synaptic element" );
   }
-  z_ = growth_curve_->update( t, t_minus, Ca_minus, z_, tau_Ca, growth_rate_ );
+  z_ = growth_curve_->update( t, t_minus, Ca_minus, z_, tau_Ca, growth_rate_, Ca_trace );
   z_t_ = t;
 }
@@ -86,6 +86,7 @@
 
 // C++ includes:
 #include <cmath>
+#include <vector>
 
 // Includes from nestkernel:
 #include "growth_curve.h"
@@ -162,8 +163,10 @@ public:
    * @param t_minus Time of last update
    * @param Ca_minus Calcium concentration at time t_minus
    * @param tau_Ca change in the calcium concentration on each spike
+   * @param Ca_trace Calcium concentration integrated from t_minus to t,
+   *        only used if the growth curve uses a calcium trace
    */
-  void update( double t, double t_minus, double Ca_minus, double tau_Ca );
+  void update( double t, double t_minus, double Ca_minus, double tau_Ca, const std::vector< double >& Ca_trace );
 
   /**
   * \fn double get_z_value(Archiving_Node const *a, double t) const
@@ -259,6 +262,16 @@ public:
     return continuous_;
   }
 
+  /*
+   * Returns true if the growth curve integrates the calcium concentration
+   * numerically and needs a calcium trace for update()
+   */
+  bool
+  uses_calcium_trace() const
+  {
+    return growth_curve_->uses_calcium_trace();
+  }
+
 private:
   // The current number of synaptic elements at t = z_t_
   double z_;
@@ -102,6 +102,7 @@ __all__ = [
     'help',
     'helpdesk',
     'message',
+    'read_binary_recording',
     'set_verbosity',
     'sysinfo',
     'version',
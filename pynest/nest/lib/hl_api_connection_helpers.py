@@ -145,7 +145,8 @@ def _process_spatial_projections(conn_spec, syn_spec):
     for the SLI function `ConnectLayers`.
     """
     allowed_conn_spec_keys = ['mask', 'allow_multapses', 'allow_autapses', 'rule',
-                              'indegree', 'outdegree', 'p', 'use_on_source', 'allow_oversized_mask']
+                              'indegree', 'outdegree', 'p', 'use_on_source', 'allow_oversized_mask',
+                              'spatial_index']
     allowed_syn_spec_keys = ['weight', 'delay', 'synapse_model']
     for key in conn_spec.keys():
         if key not in allowed_conn_spec_keys:
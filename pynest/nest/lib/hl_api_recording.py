@@ -0,0 +1,126 @@
+# -*- coding: utf-8 -*-
+#
+# hl_api_recording.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Functions for reading recorded data
+"""
+
+import struct
+
+import numpy
+
+__all__ = [
+    'read_binary_recording',
+]
+
+
+def _read_binary_file(fname):
+    """Read a single file written by the `binary` recording backend.
+
+    See the documentation of the `binary` recording backend for a
+    description of the format.
+    """
+
+    with open(fname, 'rb') as f:
+        data = f.read()
+
+    if data[:8] != b'NESTBIN\0':
+        raise ValueError("'{}' was not written by the binary recording backend".format(fname))
+    pos = 8
+
+    def unpack(fmt):
+        nonlocal pos
+        values = struct.unpack_from(fmt, data, pos)
+        pos += struct.calcsize(fmt)
+        return values[0]
+
+    def unpack_string():
+        nonlocal pos
+        size = unpack('=I')
+        pos += size
+        return data[pos - size:pos].decode()
+
+    def unpack_column(dtype, n):
+        nonlocal pos
+        column = numpy.frombuffer(data, dtype=dtype, count=n, offset=pos)
+        pos += column.nbytes
+        return column
+
+    unpack('=I')  # version of the recording backend
+    unpack_string()  # NEST version
+    time_in_steps = unpack('=B') == 1
+    double_names = [unpack_string() for _ in range(unpack('=I'))]
+    long_names = [unpack_string() for _ in range(unpack('=I'))]
+
+    columns = ['senders']
+    dtypes = [numpy.int64]
+    if time_in_steps:
+        columns += ['times', 'offsets']
+        dtypes += [numpy.int64, numpy.float64]
+    else:
+        columns += ['times']
+        dtypes += [numpy.float64]
+    columns += double_names + long_names
+    dtypes += [numpy.float64] * len(double_names) + [numpy.int64] * len(long_names)
+
+    blocks = {name: [] for name in columns}
+    while pos < len(data):
+        n = unpack('=Q')
+        for name, dtype in zip(columns, dtypes):
+            blocks[name].append(unpack_column(dtype, n))
+
+    return {name: numpy.concatenate(blocks[name]) if blocks[name] else numpy.array([], dtype=dtype)
+            for name, dtype in zip(columns, dtypes)}
+
+
+def read_binary_recording(filenames):
+    """Read data written by the `binary` recording backend.
+
+    The data of all given files is concatenated, so that the files of
+    all threads of a recording device can be read at once.
+
+    Parameters
+    ----------
+    filenames : str or list of str
+        Name of a file, or list of names of files, as given by the
+        ``filenames`` property of the recording device
+
+    Returns
+    -------
+    dict:
+        Dictionary mapping ``senders``, ``times`` and the names of the
+        recorded values to NumPy arrays, with the same keys as the
+        ``events`` dictionary of the `memory` recording backend
+
+    Raises
+    ------
+    ValueError
+        If a file was not written by the `binary` recording backend
+    """
+
+    if isinstance(filenames, str):
+        filenames = [filenames]
+
+    data = [_read_binary_file(fname) for fname in filenames]
+    if not data:
+        return {}
+
+    return {name: numpy.concatenate([d[name] for d in data]) for name in data[0]}
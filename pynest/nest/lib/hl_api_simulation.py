@@ -273,6 +273,12 @@ def SetKernelStatus(params):
         Maximal size of MPI buffers for communication of spikes.
     max_buffer_size_target_data : int
         Maximal size of MPI buffers for communication of connections
+    use_secondary_delta : bool
+        Whether secondary events (rate and gap junction coefficients) are
+        only communicated if they changed since the last exchange
+    secondary_delta_tol : float
+        Changes of secondary event payloads up to this tolerance are not
+        communicated if use_secondary_delta is set
 
 
     Waveform relaxation method (wfr)
@@ -290,6 +296,9 @@ def SetKernelStatus(params):
         Maximal number of iterations used for waveform relaxation
     wfr_interpolation_order : int
         Interpolation order of polynomial used in wfr iterations
+    wfr_adaptive : bool
+        Whether converged neurons with unchanged input are frozen in wfr
+        iterations
 
 
     Synapses
@@ -332,6 +341,9 @@ def SetKernelStatus(params):
         The number of nodes in the network
     num_connections : int, read only, local only
         The number of connections in the network
+    spatial_position_cache_size : int, read only, local only
+        Number of bytes used to cache the positions of spatially
+        distributed nodes between calls to Connect
     local_spike_counter : int, read only
         Number of spikes fired by neurons on a given MPI rank since NEST was
         started or the last ResetKernel. Only spikes from "normal" neurons
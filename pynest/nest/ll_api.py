@@ -56,6 +56,7 @@ __all__ = [
     'set_communicator',
     'get_debug',
     'set_debug',
+    'set_spike_generator_times',
     'sli_func',
     'sli_pop',
     'sli_push',
@@ -74,6 +75,7 @@ sli_push = sps = engine.push
 sli_pop = spp = engine.pop
 take_array_index = engine.take_array_index
 connect_arrays = engine.connect_arrays
+set_spike_generator_times = engine.set_spike_generator_times
 
 
 def catching_sli_run(cmd):
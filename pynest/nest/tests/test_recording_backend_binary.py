@@ -0,0 +1,110 @@
+# -*- coding: utf-8 -*-
+#
+# test_recording_backend_binary.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+import unittest
+import numpy as np
+import nest
+
+
+class TestRecordingBackendBinary(unittest.TestCase):
+
+    def testFileContentMatchesMemory(self):
+        """Test that binary files contain the same data as the memory backend."""
+
+        for buffer_size in [1, 7, 1024]:
+            nest.ResetKernel()
+            kernel_params = {
+                "overwrite_files": True,
+                "local_num_threads": 2,
+                "recording_backends": {"binary": {"buffer_size": buffer_size}},
+            }
+            nest.SetKernelStatus(kernel_params)
+
+            nrns = nest.Create("iaf_psc_alpha", 4, {"I_e": 500.})
+            mm_params = {"interval": 0.1, "record_from": ["V_m"]}
+            mm_bin = nest.Create("multimeter", params=dict(mm_params, record_to="binary"))
+            mm_mem = nest.Create("multimeter", params=dict(mm_params, record_to="memory"))
+            sr_bin = nest.Create("spike_recorder", params={"record_to": "binary"})
+            sr_mem = nest.Create("spike_recorder", params={"record_to": "memory"})
+
+            nest.Connect(mm_bin + mm_mem, nrns)
+            nest.Connect(nrns, sr_bin + sr_mem)
+
+            # files are re-opened by every call to Simulate
+            with nest.RunManager():
+                nest.Run(50.)
+                nest.Run(25.)
+
+            for rec_bin, rec_mem in [(mm_bin, mm_mem), (sr_bin, sr_mem)]:
+                data = nest.read_binary_recording(rec_bin.get("filenames"))
+                events = rec_mem.get("events")
+
+                self.assertEqual(len(data["senders"]), rec_bin.get("n_events"))
+
+                order_bin = np.lexsort((data["senders"], data["times"]))
+                order_mem = np.lexsort((events["senders"], events["times"]))
+                for key in events:
+                    np.testing.assert_allclose(data[key][order_bin], events[key][order_mem])
+
+    def testTimeInSteps(self):
+        """Check that time_in_steps stores steps and offsets."""
+
+        nest.ResetKernel()
+        nest.SetKernelStatus({"overwrite_files": True})
+
+        sr = nest.Create("spike_recorder", params={"record_to": "binary", "time_in_steps": True})
+        nest.Connect(nest.Create("spike_generator", params={"spike_times": [1.0, 2.5]}), sr)
+
+        nest.Simulate(10.)
+
+        data = nest.read_binary_recording(sr.get("filenames"))
+        np.testing.assert_array_equal(data["times"], [10, 25])
+        np.testing.assert_array_equal(data["offsets"], [0., 0.])
+
+    def testLabel(self):
+        """Test that label replaces the model name in the file name if set."""
+
+        nest.ResetKernel()
+
+        mm = nest.Create("multimeter", {"record_to": "binary", "label": "label"})
+        fname = mm.get("filenames")[0]
+
+        self.assertTrue("label" in fname)
+        self.assertTrue(fname.endswith(".nbin"))
+
+    def testInvalidBufferSize(self):
+        """Test that non-positive buffer sizes are rejected."""
+
+        nest.ResetKernel()
+
+        with self.assertRaises(nest.kernel.NESTErrors.BadProperty):
+            nest.SetKernelStatus({"recording_backends": {"binary": {"buffer_size": 0}}})
+
+
+def suite():
+    suite = unittest.TestLoader()
+    suite = suite.loadTestsFromTestCase(TestRecordingBackendBinary)
+    return suite
+
+
+if __name__ == '__main__':
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
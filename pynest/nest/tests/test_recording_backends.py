@@ -68,7 +68,7 @@ class TestRecordingBackends(unittest.TestCase):
         nest.ResetKernel()
 
         backends = nest.GetKernelStatus("recording_backends")
-        expected_backends = ("ascii", "memory", "screen")
+        expected_backends = ("ascii", "binary", "memory", "screen")
 
         self.assertTrue(all([b in backends for b in expected_backends]))
 
@@ -114,6 +114,97 @@ class TestStructuralPlasticityManager(unittest.TestCase):
                     20, len(nest.GetConnections(neurons, neurons, syn_model)))
                 break
 
+    def test_synapse_deletion(self):
+        syn_model = 'static_synapse'
+        nest.SetStructuralPlasticityStatus({
+            'structural_plasticity_update_interval': 10.,
+            'structural_plasticity_synapses': {
+                'syn1': {
+                    'synapse_model': syn_model,
+                    'pre_synaptic_element': 'SE1',
+                    'post_synaptic_element': 'SE2'
+                }
+            }
+        })
+        neurons = nest.Create('iaf_psc_alpha', 20, {
+            'synaptic_elements': {
+                'SE1': {'z': 7.0, 'growth_rate': -0.01},
+                'SE2': {'z': 4.0, 'growth_rate': -0.008}
+            }
+        })
+        nest.EnableStructuralPlasticity()
+        n_connections = []
+        for _ in range(5):
+            nest.Simulate(100.0)
+            n_connections.append(
+                len(nest.GetConnections(neurons, neurons, syn_model)))
+
+            # every created or deleted synapse updates the connected
+            # elements of both its source and its target
+            for neuron in neurons:
+                st_neuron = neuron.get('synaptic_elements')
+                self.assertEqual(
+                    st_neuron['SE1']['z_connected'],
+                    len(nest.GetConnections(neuron, None, syn_model)))
+                self.assertEqual(
+                    st_neuron['SE2']['z_connected'],
+                    len(nest.GetConnections(None, neuron, syn_model)))
+
+        self.assertGreater(n_connections[0], 0)
+        self.assertEqual(0, n_connections[-1])
+
+    def test_spike_delivery_after_updates(self):
+        nest.CopyModel('static_synapse', 'sp_synapse',
+                       {'weight': 1.0, 'delay': 1.0})
+        nest.SetStructuralPlasticityStatus({
+            'structural_plasticity_update_interval': 10.,
+            'structural_plasticity_synapses': {
+                'syn1': {
+                    'synapse_model': 'sp_synapse',
+                    'pre_synaptic_element': 'SE1',
+                    'post_synaptic_element': 'SE2'
+                }
+            }
+        })
+        generator = nest.Create('spike_generator', params={
+            'spike_times': [5.0 + 10.0 * i for i in range(30)]})
+        sources = nest.Create('parrot_neuron', 100, {
+            'synaptic_elements': {
+                'SE1': {'z': 100.0, 'growth_rate': 0.2, 'tau_vacant': 1e-4}
+            }
+        })
+        targets_params = {'E_L': 0.0, 'V_m': 0.0, 'V_th': 1e9, 'tau_m': 1e12}
+        growing = nest.Create('iaf_psc_delta', 50, dict(targets_params, **{
+            'synaptic_elements': {
+                'SE2': {'z': 100.0, 'growth_rate': 0.05, 'tau_vacant': 1e-4}
+            }
+        }))
+        shrinking = nest.Create('iaf_psc_delta', 50, dict(targets_params, **{
+            'synaptic_elements': {
+                'SE2': {'z': 100.0, 'growth_rate': -0.05, 'tau_vacant': 1e-4}
+            }
+        }))
+        targets = growing + shrinking
+        nest.Connect(generator, sources)
+        nest.Connect(sources, targets, 'all_to_all', {
+            'synapse_model': 'sp_synapse',
+            'pre_synaptic_element': 'SE1',
+            'post_synaptic_element': 'SE2'
+        })
+        nest.EnableStructuralPlasticity()
+
+        # every interval contains one spike of each source, which each
+        # target receives once per incoming connection after the update
+        # of the connection infrastructure
+        v_m = targets.get('V_m')
+        for _ in range(30):
+            nest.Simulate(10.0)
+            new_v_m = targets.get('V_m')
+            for target, v_old, v_new in zip(targets, v_m, new_v_m):
+                indegree = len(nest.GetConnections(None, target, 'sp_synapse'))
+                self.assertAlmostEqual(indegree, v_new - v_old, places=6)
+            v_m = new_v_m
+
 
 def suite():
     test_suite = unittest.makeSuite(TestStructuralPlasticityManager, 'test')
@@ -91,6 +91,33 @@ class TestSynapticElements(unittest.TestCase):
         self.assertDictContainsSubset(
             synaptic_element_dict2[u'SE2'], neuron_synaptic_elements[u'SE2'])
 
+    def test_shared_calcium_trace(self):
+        gaussian = {u'growth_curve': u'gaussian', u'z': 5.0,
+                    u'growth_rate': 0.1, u'eps': 0.05, u'eta': 0.02}
+        sigmoid = {u'growth_curve': u'sigmoid', u'z': 5.0,
+                   u'growth_rate': 0.1, u'eps': 0.05, u'psi': 0.1}
+        linear = {u'growth_curve': u'linear', u'z': 5.0,
+                  u'growth_rate': 0.1, u'eps': 0.05}
+
+        # elements sharing the calcium trace of one neuron evolve
+        # exactly like the same elements on separate neurons
+        params = {u'beta_Ca': 0.01, u'tau_Ca': 100.0, u'I_e': 600.0}
+        shared = nest.Create('iaf_psc_alpha', 1, dict(params, **{
+            u'synaptic_elements': {
+                u'SE1': gaussian, u'SE2': sigmoid, u'SE3': linear}}))
+        single = nest.Create('iaf_psc_alpha', 3, params)
+        single[0].set({u'synaptic_elements': {u'SE1': gaussian}})
+        single[1].set({u'synaptic_elements': {u'SE2': sigmoid}})
+        single[2].set({u'synaptic_elements': {u'SE3': linear}})
+
+        nest.Simulate(200.0)
+
+        shared_elements = shared.get(u'synaptic_elements')
+        for neuron, name in zip(single, [u'SE1', u'SE2', u'SE3']):
+            self.assertEqual(
+                shared_elements[name][u'z'],
+                neuron.get(u'synaptic_elements')[name][u'z'])
+
 
 def suite():
     test_suite = unittest.makeSuite(TestSynapticElements, 'test')
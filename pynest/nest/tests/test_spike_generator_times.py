@@ -0,0 +1,83 @@
+# -*- coding: utf-8 -*-
+#
+# test_spike_generator_times.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+import unittest
+import numpy as np
+
+import nest
+
+nest.set_verbosity('M_WARNING')
+
+
+class TestSpikeGeneratorTimes(unittest.TestCase):
+
+    times = np.array([1., 2.5, 4., 3., 1.5, 2., 6.5])
+    offsets = np.array([0, 3, 4, 4, 7])
+
+    def setUp(self):
+        nest.ResetKernel()
+
+    def check_times(self, threads):
+        nest.SetKernelStatus({'local_num_threads': threads})
+        sgs = nest.Create('spike_generator', 4)
+        srs = nest.Create('spike_recorder', 4)
+        nest.Connect(sgs, srs, 'one_to_one')
+
+        nest.ll_api.set_spike_generator_times(np.array(sgs.tolist()), self.times, self.offsets)
+        nest.Simulate(10.)
+
+        for i in range(len(sgs)):
+            expected = self.times[self.offsets[i]:self.offsets[i + 1]]
+            np.testing.assert_array_equal(sgs[i].spike_times, expected)
+            np.testing.assert_array_equal(np.sort(srs[i].events['times']), expected)
+
+    def test_set_spike_generator_times(self):
+        """Setting spike times of generators from one array"""
+        self.check_times(1)
+
+    def test_set_spike_generator_times_threaded(self):
+        """Setting spike times of generators from one array with two threads"""
+        self.check_times(2)
+
+    def test_set_spike_generator_times_unsorted(self):
+        """Unsorted spike times of one generator are rejected"""
+        sgs = nest.Create('spike_generator', 2)
+        with self.assertRaises(nest.kernel.NESTError):
+            nest.ll_api.set_spike_generator_times(np.array(sgs.tolist()), np.array([1., 2., 2., 1.]),
+                                                  np.array([0, 2, 4]))
+
+    def test_set_spike_generator_times_wrong_offsets(self):
+        """Offsets must match the generators and times"""
+        sgs = nest.Create('spike_generator', 2)
+        with self.assertRaises(ValueError):
+            nest.ll_api.set_spike_generator_times(np.array(sgs.tolist()), self.times, np.array([0, 3]))
+        with self.assertRaises(ValueError):
+            nest.ll_api.set_spike_generator_times(np.array(sgs.tolist()), self.times, np.array([0, 3, 8]))
+
+
+def suite():
+    suite = unittest.TestLoader().loadTestsFromTestCase(TestSpikeGeneratorTimes)
+    return suite
+
+
+if __name__ == '__main__':
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
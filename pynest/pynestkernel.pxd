@@ -150,6 +150,7 @@ cdef extern from "nest.h" namespace "nest":
     Datum* node_collection_array_index(const Datum* node_collection, const long* array, unsigned long n) except +
     Datum* node_collection_array_index(const Datum* node_collection, const cbool* array, unsigned long n) except +
     void connect_arrays( long* sources, long* targets, double* weights, double* delays, vector[string]& p_keys, double* p_values, size_t n, string syn_model ) except +
+    void set_spike_generator_times( long* node_ids, size_t n, double* times, long* offsets ) except +
 
 cdef extern from *:
 
@@ -359,6 +359,47 @@ cdef class NESTEngine(object):
             exceptionCls = getattr(NESTErrors, str(e))
             raise exceptionCls('connect_arrays', '') from None
 
+    def set_spike_generator_times(self, node_ids, times, offsets):
+        """Calls set_spike_generator_times function, bypassing SLI to expose pointers to the NumPy arrays"""
+        if self.pEngine is NULL:
+            raise NESTErrors.PyNESTError("engine uninitialized")
+        if not HAVE_NUMPY:
+            raise NESTErrors.PyNESTError("NumPy is not available")
+
+        if not (isinstance(node_ids, numpy.ndarray) and node_ids.ndim == 1) or not numpy.issubdtype(node_ids.dtype, numpy.integer):
+            raise TypeError('node_ids must be a 1-dimensional NumPy array of integers')
+        if not (isinstance(times, numpy.ndarray) and times.ndim == 1):
+            raise TypeError('times must be a 1-dimensional NumPy array')
+        if not (isinstance(offsets, numpy.ndarray) and offsets.ndim == 1) or not numpy.issubdtype(offsets.dtype, numpy.integer):
+            raise TypeError('offsets must be a 1-dimensional NumPy array of integers')
+
+        if not len(offsets) == len(node_ids) + 1:
+            raise ValueError('offsets must have one element more than node_ids.')
+        if len(offsets) > 0 and offsets[-1] > len(times):
+            raise ValueError('offsets must not point beyond the end of times.')
+
+        # Get pointers to the first element in each NumPy array
+        cdef long[::1] node_ids_mv
+        cdef long* node_ids_ptr = NULL
+        if len(node_ids) > 0:
+            node_ids_mv = numpy.ascontiguousarray(node_ids, dtype=numpy.long)
+            node_ids_ptr = &node_ids_mv[0]
+
+        cdef double[::1] times_mv
+        cdef double* times_ptr = NULL
+        if len(times) > 0:
+            times_mv = numpy.ascontiguousarray(times, dtype=numpy.double)
+            times_ptr = &times_mv[0]
+
+        cdef long[::1] offsets_mv = numpy.ascontiguousarray(offsets, dtype=numpy.long)
+        cdef long* offsets_ptr = &offsets_mv[0]
+
+        try:
+            set_spike_generator_times( node_ids_ptr, len(node_ids), times_ptr, offsets_ptr )
+        except RuntimeError as e:
+            exceptionCls = getattr(NESTErrors, str(e))
+            raise exceptionCls('set_spike_generator_times', '') from None
+
 cdef inline Datum* python_object_to_datum(obj) except NULL:
 
     cdef Datum* ret = NULL
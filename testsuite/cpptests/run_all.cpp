@@ -27,6 +27,7 @@
 // Includes from cpptests
 #include "test_block_vector.h"
 #include "test_enum_bitfield.h"
+#include "test_sliding_window.h"
 #include "test_sort.h"
 #include "test_streamers.h"
 #include "test_target_fields.h"
@@ -0,0 +1,75 @@
+/*
+ *  test_sliding_window.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TEST_SLIDING_WINDOW_H
+#define TEST_SLIDING_WINDOW_H
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+// C++ includes:
+#include <algorithm>
+#include <deque>
+
+// Includes from libnestutil:
+#include "sliding_window.h"
+
+BOOST_AUTO_TEST_SUITE( test_sliding_window )
+
+/**
+ * Tests whether sorted insertion and removal from the front give the same
+ * sequence as with a deque, also after the window has been compacted.
+ */
+BOOST_AUTO_TEST_CASE( test_insert_pop_front )
+{
+  nest::SlidingWindow< int > window;
+  std::deque< int > reference;
+
+  for ( int i = 0; i < 1000; ++i )
+  {
+    // mostly increasing values, inserted slightly out of order
+    const int value = i - ( i % 7 == 3 ? 5 : 0 );
+    window.insert( window.upper_bound( value ), value );
+    reference.insert( std::upper_bound( reference.begin(), reference.end(), value ), value );
+
+    while ( reference.front() < i - 20 )
+    {
+      BOOST_REQUIRE( window.front() == reference.front() );
+      window.pop_front();
+      reference.pop_front();
+    }
+
+    BOOST_REQUIRE( window.size() == reference.size() );
+    BOOST_REQUIRE( std::equal( reference.begin(), reference.end(), window.begin() ) );
+  }
+
+  while ( not reference.empty() )
+  {
+    window.pop_front();
+    reference.pop_front();
+  }
+  BOOST_REQUIRE( window.empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* TEST_SLIDING_WINDOW_H */